@@ -0,0 +1,496 @@
+//! dino_bench: Headless tick-throughput harness for the simulation library.
+//! Runs N ticks of World::Update() on a seeded scene and reports throughput and per-phase timings.
+//! With --render, every tick is also colorized into a CPU pixel buffer the way Renderer does it
+//! (full frame first, then only the chunks that changed) and the would-be upload size is reported.
+//! --load starts from a snapshot instead of a scene (fixtures); --save writes the final state (--raw: uncompressed).
+//! --csv streams per-tick phase timings and work counters (same columns as the game's profiler).
+//! --view limits rendering to a centered W x H region, the way the game's viewport does.
+//! --coarse-heat turns on the hierarchical thermal mode; the warm-cell share shows how far heat got.
+//! --emit writes a delta-compressed frame stream (see FrameStream.h) every --emit-every ticks to a
+//! file, stdout ("-") or a local socket ("unix:PATH"), for dino_view; --emit-key N adds a key
+//! frame every N frames.
+//! --expect-ambient fails the run unless every cell ended up at ambient with the heat schedule
+//! asleep (e.g. the cooldown scene).
+//! --suite runs every canonical scene (see Scenes.cpp) at each of --sizes, with rendering, and
+//! writes machine-readable results (ns/tick, cells/sec, render ns/frame, peak RSS) to --json.
+//!
+//! Usage: dino_bench [--width W] [--height H] [--ticks N] [--warmup N] [--seed S] [--scene NAME] [--threads T] [--render none|standard|thermal] [--view W H] [--load FILE] [--save FILE] [--raw] [--csv FILE] [--coarse-heat] [--emit TARGET] [--emit-every N] [--emit-key N] [--expect-ambient]
+//!        dino_bench --suite [--sizes 256,512,1024] [--ticks N] [--warmup N] [--seed S] [--threads T] [--json FILE] [--coarse-heat]
+
+#include "Simulation/World.h"
+#include "Simulation/Elements.h"
+#include "Simulation/Random.h"
+#include "Simulation/ThermalKernel.h"
+#include "Simulation/Snapshot.h"
+#include "Simulation/FrameStream.h"
+#include "Core/Profiler.h"
+#include "Graphics/Colorizer.h"
+#include "Scenes.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+struct BenchOptions {
+    int width = 320;
+    int height = 160;
+    int ticks = 1000;
+    int warmup = 50;
+    unsigned int seed = 1234;
+    std::string scene = "mixed";
+    int threads = 1;
+    std::string render = "none";
+    int viewWidth = 0;   //! Rendered region (centered, like a camera); 0 = whole world
+    int viewHeight = 0;
+    std::string load;    //! Snapshot to start from (overrides --scene, --width, --height)
+    std::string save;    //! Snapshot written after the run
+    bool raw = false;    //! Save uncompressed
+    std::string csv;     //! Per-tick profiler stream
+    bool coarseHeat = false;
+    std::string emit;    //! Frame stream target ("" = none)
+    int emitEvery = 1;   //! Ticks per streamed frame
+    int emitKey = 0;     //! Frames per key frame (0 = first only)
+    bool expectAmbient = false;  //! Fail unless every cell ends at ambient with heat asleep
+
+    bool suite = false;                         //! Canonical scene suite instead of a single run
+    std::vector<int> sizes = { 256, 512, 1024 };  //! Square grid sizes of the suite
+    std::string json;                           //! Suite results file ("" = stdout)
+    bool ticksSet = false;
+};
+
+//! "256,512,1024" -> sizes; false on anything that is not a positive list
+static bool ParseSizes(const char* text, std::vector<int>& sizes) {
+    sizes.clear();
+    for (const char* p = text; *p;) {
+        char* end;
+        long v = std::strtol(p, &end, 10);
+        if (end == p || v < 3) return false;
+        sizes.push_back((int)v);
+        p = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return false;
+    }
+    return !sizes.empty();
+}
+
+static bool ParseArgs(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--width") == 0 && hasValue) opt.width = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--height") == 0 && hasValue) opt.height = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--ticks") == 0 && hasValue) { opt.ticks = std::atoi(argv[++i]); opt.ticksSet = true; }
+        else if (std::strcmp(arg, "--warmup") == 0 && hasValue) opt.warmup = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--seed") == 0 && hasValue) opt.seed = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--scene") == 0 && hasValue) opt.scene = argv[++i];
+        else if (std::strcmp(arg, "--threads") == 0 && hasValue) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--render") == 0 && hasValue) opt.render = argv[++i];
+        else if (std::strcmp(arg, "--load") == 0 && hasValue) opt.load = argv[++i];
+        else if (std::strcmp(arg, "--save") == 0 && hasValue) opt.save = argv[++i];
+        else if (std::strcmp(arg, "--raw") == 0) opt.raw = true;
+        else if (std::strcmp(arg, "--csv") == 0 && hasValue) opt.csv = argv[++i];
+        else if (std::strcmp(arg, "--suite") == 0) opt.suite = true;
+        else if (std::strcmp(arg, "--coarse-heat") == 0) opt.coarseHeat = true;
+        else if (std::strcmp(arg, "--emit") == 0 && hasValue) opt.emit = argv[++i];
+        else if (std::strcmp(arg, "--emit-every") == 0 && hasValue) opt.emitEvery = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--emit-key") == 0 && hasValue) opt.emitKey = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--expect-ambient") == 0) opt.expectAmbient = true;
+        else if (std::strcmp(arg, "--sizes") == 0 && hasValue) { if (!ParseSizes(argv[++i], opt.sizes)) return false; }
+        else if (std::strcmp(arg, "--json") == 0 && hasValue) opt.json = argv[++i];
+        else if (std::strcmp(arg, "--view") == 0 && i + 2 < argc) { opt.viewWidth = std::atoi(argv[++i]); opt.viewHeight = std::atoi(argv[++i]); }
+        else {
+            std::fprintf(stderr, "Usage: %s [--width W] [--height H] [--ticks N] [--warmup N] [--seed S] [--scene NAME] [--threads T] [--render none|standard|thermal] [--view W H] [--load FILE] [--save FILE] [--raw] [--csv FILE] [--coarse-heat] [--emit TARGET] [--emit-every N] [--emit-key N] [--expect-ambient]\n", argv[0]);
+            std::fprintf(stderr, "       %s --suite [--sizes 256,512,1024] [--ticks N] [--warmup N] [--seed S] [--threads T] [--render standard|thermal] [--json FILE] [--coarse-heat]\n", argv[0]);
+            std::fprintf(stderr, "Scenes:\n");
+            for (const SceneDef& scene : GetScenes()) std::fprintf(stderr, "  %-12s %s%s\n", scene.name, scene.description, scene.inSuite ? " (suite)" : "");
+            return false;
+        }
+    }
+    if (!FindScene(opt.scene.c_str())) {
+        std::fprintf(stderr, "Unknown scene '%s'\n", opt.scene.c_str());
+        return false;
+    }
+    if (opt.render != "none" && opt.render != "standard" && opt.render != "thermal") {
+        std::fprintf(stderr, "Unknown render mode '%s'\n", opt.render.c_str());
+        return false;
+    }
+    return opt.width > 2 && opt.height > 2 && opt.ticks > 0 && opt.warmup >= 0 && opt.viewWidth >= 0 && opt.viewHeight >= 0;
+}
+//! Peak resident set size of the process so far (KB)
+static long long PeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return (long long)(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss / 1024; //! Bytes on macOS
+#else
+    return (long long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+//! FNV-1a over the grid state; equal hashes mean bit-identical runs
+static unsigned long long HashWorld(const World& world) {
+    unsigned long long h = 1469598103934665603ull;
+    auto feed = [&h](const void* data, size_t bytes) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t k = 0; k < bytes; k++) { h ^= p[k]; h *= 1099511628211ull; }
+    };
+    //! Row-major whatever the storage layout, so both layouts hash alike
+    const GridLayout& layout = world.GetLayout();
+    for (int y = 0; y < world.GetHeight(); y++) {
+        layout.ForEachRun(0, y, world.GetWidth(), [&](int i, int, int length) { feed(&world.GetGridData()[i], length * sizeof(CellType)); });
+    }
+    for (int y = 0; y < world.GetHeight(); y++) {
+        layout.ForEachRun(0, y, world.GetWidth(), [&](int i, int, int length) { feed(&world.GetTempData()[i], length * sizeof(CellTemp)); });
+    }
+    return h;
+}
+
+//! Share of cells more than WARM_DELTA degrees above ambient
+static const float WARM_DELTA = 10.0f;
+static double WarmShare(const World& world) {
+    const GridLayout& layout = world.GetLayout();
+    const CellTemp* temps = world.GetTempData().data();
+    long long warm = 0;
+    for (int y = 0; y < world.GetHeight(); y++) {
+        layout.ForEachRun(0, y, world.GetWidth(), [&](int i, int, int length) {
+            for (int k = 0; k < length; k++) warm += DecodeTemp(temps[i + k]) > AMBIENT_TEMP + WARM_DELTA;
+        });
+    }
+    return (double)warm / ((double)world.GetWidth() * world.GetHeight());
+}
+
+//! Cells further than AMBIENT_TOLERANCE degrees from ambient, and the largest distance
+static const float AMBIENT_TOLERANCE = 0.1f;
+static long long OffAmbientCells(const World& world, float& maxDistance) {
+    const GridLayout& layout = world.GetLayout();
+    const CellTemp* temps = world.GetTempData().data();
+    long long off = 0;
+    maxDistance = 0.0f;
+    for (int y = 0; y < world.GetHeight(); y++) {
+        layout.ForEachRun(0, y, world.GetWidth(), [&](int i, int, int length) {
+            for (int k = 0; k < length; k++) {
+                float distance = std::fabs(DecodeTemp(temps[i + k]) - AMBIENT_TEMP);
+                off += distance > AMBIENT_TOLERANCE;
+                maxDistance = std::max(maxDistance, distance);
+            }
+        });
+    }
+    return off;
+}
+
+//! --suite: every canonical scene at every size, simulated and rendered like the game does.
+//! Sizes run in the given order; peak RSS is the process high-water mark after each run.
+static int RunSuite(const BenchOptions& opt) {
+    int ticks = opt.ticksSet ? opt.ticks : 200;
+    bool thermal = opt.render == "thermal";
+
+    FILE* out = stdout;
+    if (!opt.json.empty() && !(out = std::fopen(opt.json.c_str(), "w"))) {
+        std::fprintf(stderr, "Cannot write '%s'\n", opt.json.c_str());
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"dino_bench suite\",\n");
+    std::fprintf(out, "  \"thermal_simd\": \"%s\",\n  \"cell_bytes\": %d,\n", ThermalKernel::GetInstructionSet(), World::BYTES_PER_CELL);
+    std::fprintf(out, "  \"grid_layout\": \"%s\",\n  \"coarse_heat\": %s,\n", GridLayout::TILED ? "tiled" : "row-major", opt.coarseHeat ? "true" : "false");
+    std::fprintf(out, "  \"threads\": %d,\n  \"ticks\": %d,\n  \"warmup\": %d,\n  \"seed\": %u,\n  \"render\": \"%s\",\n",
+        std::max(opt.threads, 1), ticks, opt.warmup, opt.seed, thermal ? "thermal" : "standard");
+    std::fprintf(out, "  \"results\": [");
+
+    Colorizer colorizer;
+    std::vector<std::uint32_t> pixels;
+    std::vector<PixelRect> dirtyRects;
+    bool first = true;
+
+    for (int size : opt.sizes) {
+        pixels.assign((size_t)size * size, 0);
+
+        for (const SceneDef& scene : GetScenes()) {
+            if (!scene.inSuite) continue;
+
+            Random::Seed(opt.seed);
+            World world(size, size);
+            world.SetSeed(opt.seed);
+            world.SetThreadCount(opt.threads);
+            world.SetCoarseHeat(opt.coarseHeat);
+            scene.build(world);
+            for (int t = 0; t < opt.warmup; t++) world.Update();
+
+            TickTimings total;
+            double updateMs = 0.0, renderMs = 0.0, activeCells = 0.0, heatCells = 0.0;
+            std::uint32_t drawnEpoch = 0;
+
+            for (int t = 0; t < ticks; t++) {
+                {
+                    ScopedTimer timer(updateMs);
+                    world.Update();
+                }
+                {
+                    //! Same work as Renderer::DrawSimulation without the GPU upload
+                    ScopedTimer timer(renderMs);
+                    GridView grid = world.GetView();
+                    if (t == 0) dirtyRects.assign(1, PixelRect{ 0, 0, size, size });
+                    else Colorizer::CollectChangedRects(grid, drawnEpoch, dirtyRects);
+                    drawnEpoch = grid.changeEpoch;
+                    for (const PixelRect& r : dirtyRects)
+                        colorizer.ColorizeRect(grid, thermal, (unsigned int)t, r.x0, r.y0, r.x1, r.y1, pixels.data(), r.x1 - r.x0);
+                }
+
+                const TickTimings& phase = world.GetLastTimings();
+                total.thermo += phase.thermo;
+                total.solids += phase.solids;
+                total.gases += phase.gases;
+                activeCells += world.GetActiveCellCount();
+                heatCells += world.GetHeatCellCount();
+            }
+
+            double cells = (double)size * size;
+            double nsPerTick = updateMs * 1e6 / ticks;
+            std::fprintf(out, "%s\n    { \"scene\": \"%s\", \"width\": %d, \"height\": %d, \"cells\": %.0f,", first ? "" : ",", scene.name, size, size, cells);
+            std::fprintf(out, " \"ns_per_tick\": %.0f, \"cells_per_sec\": %.4e,", nsPerTick, cells * ticks / (updateMs / 1000.0));
+            std::fprintf(out, " \"thermo_ns\": %.0f, \"solids_ns\": %.0f, \"gases_ns\": %.0f,", total.thermo * 1e6 / ticks, total.solids * 1e6 / ticks, total.gases * 1e6 / ticks);
+            std::fprintf(out, " \"render_ns_per_frame\": %.0f, \"active_cells_pct\": %.2f, \"heat_cells_pct\": %.2f,",
+                renderMs * 1e6 / ticks, 100.0 * activeCells / ticks / cells, 100.0 * heatCells / ticks / cells);
+            std::fprintf(out, " \"warm_cells_pct\": %.2f,", 100.0 * WarmShare(world));
+            std::fprintf(out, " \"peak_rss_kb\": %lld, \"state_hash\": \"%016llx\" }", PeakRssKb(), HashWorld(world));
+            std::fflush(out);
+            first = false;
+
+            std::fprintf(stderr, "%-12s %5d^2 : %10.4f ms/tick, render %8.4f ms/frame\n", scene.name, size, updateMs / ticks, renderMs / ticks);
+        }
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!ParseArgs(argc, argv, opt)) return 1;
+    if (opt.suite) return RunSuite(opt);
+
+    Random::Seed(opt.seed);
+
+    Snapshot::Info info = {};
+    if (!opt.load.empty()) {
+        if (!Snapshot::ReadInfo(opt.load, info)) {
+            std::fprintf(stderr, "Cannot read snapshot '%s'\n", opt.load.c_str());
+            return 1;
+        }
+        opt.width = info.width;
+        opt.height = info.height;
+        opt.seed = info.seed;
+        opt.scene = "snapshot";
+    }
+
+    World world(opt.width, opt.height);
+    world.SetSeed(opt.seed);
+    world.SetThreadCount(opt.threads);
+    world.SetCoarseHeat(opt.coarseHeat);
+
+    double loadMs = 0.0;
+    if (!opt.load.empty()) {
+        auto loadStart = std::chrono::steady_clock::now();
+        if (!Snapshot::Load(opt.load, world)) {
+            std::fprintf(stderr, "Cannot load snapshot '%s'\n", opt.load.c_str());
+            return 1;
+        }
+        loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    }
+    else FindScene(opt.scene.c_str())->build(world);
+
+    for (int t = 0; t < opt.warmup; t++) world.Update();
+
+    bool render = opt.render != "none";
+    int viewW = opt.viewWidth > 0 ? std::min(opt.viewWidth, opt.width) : opt.width;
+    int viewH = opt.viewHeight > 0 ? std::min(opt.viewHeight, opt.height) : opt.height;
+    PixelRect view = { (opt.width - viewW) / 2, (opt.height - viewH) / 2, (opt.width - viewW) / 2 + viewW, (opt.height - viewH) / 2 + viewH };
+
+    Colorizer colorizer;
+    std::vector<std::uint32_t> pixels(render ? (size_t)viewW * viewH : 0);
+    std::vector<PixelRect> dirtyRects;
+    std::uint32_t drawnEpoch = 0;
+    double renderMs = 0.0;
+    double uploadedBytes = 0.0;
+
+    Profiler profiler;
+    if (!opt.csv.empty() && !profiler.OpenCsv(opt.csv)) {
+        std::fprintf(stderr, "Cannot write '%s'\n", opt.csv.c_str());
+        return 1;
+    }
+
+    //! Frame stream: the starting state, then every emitEvery ticks and the final tick.
+    //! When the stream goes to stdout the report goes to stderr.
+    std::FILE* report = opt.emit == "-" ? stderr : stdout;
+    std::FILE* stream = nullptr;
+    FrameEncoder encoder(opt.emitKey);
+    double emitMs = 0.0;
+    if (!opt.emit.empty()) {
+        stream = FrameStream::OpenOutput(opt.emit);
+        if (!stream || !encoder.Write(stream, world.GetView())) {
+            std::fprintf(stderr, "Cannot write a frame stream to '%s'\n", opt.emit.c_str());
+            FrameStream::Close(stream);
+            return 1;
+        }
+    }
+
+    TickTimings total;
+    double activeCells = 0.0, heatCells = 0.0;
+    double cellsMoved = 0.0, reactions = 0.0, phaseChanges = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < opt.ticks; t++) {
+        double updateMs = 0.0;
+        {
+            ScopedTimer timer(updateMs);
+            world.Update();
+        }
+
+        if (render) {
+            bool thermal = opt.render == "thermal";
+            auto renderStart = std::chrono::steady_clock::now();
+
+            GridView grid = world.GetView();
+            if (t == 0) dirtyRects.assign(1, view);
+            else Colorizer::CollectChangedRects(grid, drawnEpoch, view, dirtyRects);
+            drawnEpoch = grid.changeEpoch;
+
+            for (const PixelRect& r : dirtyRects) {
+                colorizer.ColorizeRect(grid, thermal, (unsigned int)t, r.x0, r.y0, r.x1, r.y1, pixels.data(), r.x1 - r.x0);
+                uploadedBytes += (double)r.Area() * sizeof(std::uint32_t);
+            }
+            double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+            renderMs += frameMs;
+            profiler.Record(PROF_RENDER, frameMs);
+        }
+
+        if (stream && ((t + 1) % opt.emitEvery == 0 || t + 1 == opt.ticks)) {
+            auto emitStart = std::chrono::steady_clock::now();
+            if (!encoder.Write(stream, world.GetView())) {
+                std::fprintf(stderr, "Frame stream to '%s' failed at tick %u, no longer streaming\n", opt.emit.c_str(), world.GetTick());
+                FrameStream::Close(stream);
+                stream = nullptr;
+            }
+            emitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - emitStart).count();
+        }
+
+        const TickTimings& phase = world.GetLastTimings();
+        total.thermo += phase.thermo;
+        total.solids += phase.solids;
+        total.gases += phase.gases;
+        activeCells += world.GetActiveCellCount();
+        heatCells += world.GetHeatCellCount();
+
+        const TickCounters& work = world.GetLastCounters();
+        cellsMoved += work.cellsMoved;
+        reactions += work.reactions;
+        phaseChanges += work.phaseChanges;
+
+        profiler.Record(PROF_UPDATE, updateMs);
+        profiler.Record(PROF_THERMO, phase.thermo);
+        profiler.Record(PROF_SOLIDS, phase.solids);
+        profiler.Record(PROF_GASES, phase.gases);
+        profiler.Record(PROF_CELLS_MOVED, work.cellsMoved);
+        profiler.Record(PROF_REACTIONS, work.reactions);
+        profiler.Record(PROF_PHASE_CHANGES, work.phaseChanges);
+        profiler.Record(PROF_ACTIVE_CELLS, work.activeCells);
+        profiler.Record(PROF_HEAT_CELLS, work.heatCells);
+        profiler.EndFrame(world.GetTick());
+    }
+    Profiler::Stats updateStats = profiler.GetStats(PROF_UPDATE);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() - (renderMs + emitMs) / 1000.0;
+    double cells = (double)opt.width * opt.height;
+
+    std::fprintf(report, "grid          : %d x %d (%.0f cells)\n", opt.width, opt.height, cells);
+    std::fprintf(report, "scene         : %s\n", opt.scene.c_str());
+    std::fprintf(report, "threads       : %d\n", world.GetThreadCount());
+    std::fprintf(report, "thermal simd  : %s\n", ThermalKernel::GetInstructionSet());
+    std::fprintf(report, "cell state    : %d bytes\n", World::BYTES_PER_CELL);
+    std::fprintf(report, "grid layout   : %s\n", GridLayout::TILED ? "32x32 tiles" : "row-major");
+    std::fprintf(report, "coarse heat   : %s\n", opt.coarseHeat ? "on" : "off");
+    std::fprintf(report, "ticks         : %d (+%d warmup), seed %u\n", opt.ticks, opt.warmup, opt.seed);
+    std::fprintf(report, "total         : %.3f s\n", seconds);
+    std::fprintf(report, "state hash    : %016llx\n", HashWorld(world));
+    std::fprintf(report, "ticks/sec     : %.1f\n", opt.ticks / seconds);
+    std::fprintf(report, "cells/sec     : %.3e\n", cells * opt.ticks / seconds);
+    std::fprintf(report, "active cells  : %.1f%% moving, %.1f%% heat\n", 100.0 * activeCells / opt.ticks / cells, 100.0 * heatCells / opt.ticks / cells);
+    std::fprintf(report, "ms/tick       : %.4f\n", 1000.0 * seconds / opt.ticks);
+    std::fprintf(report, "  thermo      : %.4f ms\n", total.thermo / opt.ticks);
+    std::fprintf(report, "  solids      : %.4f ms\n", total.solids / opt.ticks);
+    std::fprintf(report, "  gases       : %.4f ms\n", total.gases / opt.ticks);
+    std::fprintf(report, "update (last %d): min %.4f, avg %.4f, p99 %.4f ms\n", std::min(opt.ticks, Profiler::HISTORY), updateStats.min, updateStats.avg, updateStats.p99);
+    std::fprintf(report, "warm cells    : %.2f%% (> %.0f above ambient)\n", 100.0 * WarmShare(world), WARM_DELTA);
+    float maxDistance;
+    long long offAmbient = OffAmbientCells(world, maxDistance);
+    std::fprintf(report, "off ambient   : %lld cells (> %.1f), up to %.3f degrees, heat %s\n", offAmbient, AMBIENT_TOLERANCE, maxDistance,
+        world.GetHeatCellCount() > 0 ? "awake" : "asleep");
+    std::fprintf(report, "per tick      : %.0f moved, %.1f reactions, %.1f phase changes\n", cellsMoved / opt.ticks, reactions / opt.ticks, phaseChanges / opt.ticks);
+
+    if (!opt.load.empty()) std::fprintf(report, "snapshot load : %.3f ms (%s)\n", loadMs, opt.load.c_str());
+    if (!opt.save.empty()) {
+        auto saveStart = std::chrono::steady_clock::now();
+        if (!Snapshot::Save(world, opt.save, !opt.raw)) {
+            std::fprintf(stderr, "Cannot write snapshot '%s'\n", opt.save.c_str());
+            return 1;
+        }
+        double saveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - saveStart).count();
+        std::fprintf(report, "snapshot save : %.3f ms (%s)\n", saveMs, opt.save.c_str());
+    }
+
+    if (!opt.emit.empty()) {
+        const FrameEncoder::Stats& es = encoder.GetStats();
+        double frameBytes = cells * (sizeof(CellType) + sizeof(std::uint16_t));
+        std::fprintf(report, "stream        : %d frames (%d key) to %s, %.1f KB/frame (%.2f%% of a full frame), %.4f ms/frame\n",
+            es.frames, es.keyFrames, opt.emit.c_str(), es.bytes / 1024.0 / es.frames, 100.0 * es.bytes / es.frames / frameBytes, emitMs / es.frames);
+        std::fprintf(report, "stream hash   : %016llx\n", (unsigned long long)FrameStream::Hash(world.GetView()));
+        FrameStream::Close(stream);
+    }
+
+    if (render) {
+        //! Reference: plain copy of a buffer the same size as the frame
+        std::vector<std::uint32_t> copy(pixels.size());
+        auto copyStart = std::chrono::steady_clock::now();
+        for (int t = 0; t < opt.ticks; t++) {
+            pixels[t % pixels.size()] ^= 1u; //! Keeps the copies from being folded away
+            std::memcpy(copy.data(), pixels.data(), pixels.size() * sizeof(std::uint32_t));
+        }
+        double copyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - copyStart).count();
+
+        double frameBytes = (double)pixels.size() * sizeof(std::uint32_t);
+        std::fprintf(report, "render (%s) : %.4f ms/frame, %.2f GB/s written (memcpy %.2f GB/s)\n", opt.render.c_str(),
+            renderMs / opt.ticks, uploadedBytes / (renderMs * 1e6), frameBytes * opt.ticks / (copyMs * 1e6));
+        std::fprintf(report, "  uploaded    : %.1f KB/frame of %.1f KB (%.1f%%)\n",
+            uploadedBytes / opt.ticks / 1024.0, frameBytes / 1024.0, 100.0 * uploadedBytes / opt.ticks / frameBytes);
+    }
+
+    if (opt.expectAmbient && (offAmbient > 0 || world.GetHeatCellCount() > 0)) {
+        std::fprintf(stderr, "Not back at ambient after %d ticks\n", opt.ticks);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "Scenes.h"
+#include "Simulation/Elements.h"
+#include "Simulation/Random.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+
+//! Fills the world with a mixed scene: walled floor, sand rain, a water pool, a wood block with fire and a lava pocket
+static void BuildMixedScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int i = world.Index(x, y);
+
+            if (y >= h - 2) { world.SetCell(i, WALL); continue; }
+
+            //! Left third: loose sand in the upper half
+            if (x < w / 3 && y < h / 2 && Random::Range(0, 2) == 0) world.SetCell(i, SAND);
+            //! Middle third: water pool on the floor
+            else if (x >= w / 3 && x < 2 * w / 3 && y > h / 2) world.SetCell(i, WATER);
+            //! Right third: wood block with a lava pocket below it
+            else if (x >= 2 * w / 3 && y > h / 2 && y < 3 * h / 4) world.SetCell(i, WOOD);
+            else if (x >= 2 * w / 3 && y >= 3 * h / 4) world.SetCell(i, LAVA);
+        }
+    }
+
+    //! Ignite the top of the wood block
+    for (int x = 2 * w / 3; x < w; x += 4) world.SetCell(world.Index(x, h / 2), FIRE);
+}
+
+//! Mostly static scene: a packed sand bed around a sealed water basin, plus one small burning wood block
+static void BuildSettledScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+
+    for (int y = h / 4; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int i = world.Index(x, y);
+
+            bool inBasin = (x >= w / 2 && x <= w / 2 + w / 8 && y >= h / 2);
+
+            if (y >= h - 2 || x == 0 || x == w - 1) world.SetCell(i, WALL);
+            else if (inBasin && (y == h / 2 || x == w / 2 || x == w / 2 + w / 8)) world.SetCell(i, WALL);
+            else if (inBasin) world.SetCell(i, WATER);
+            else world.SetCell(i, SAND);
+        }
+    }
+
+    //! The only active spot: a 16x16 wood block burning above the bed
+    int bx = w / 8;
+    int by = h / 4 - 16;
+    for (int y = std::max(by, 0); y < h / 4; y++)
+        for (int x = bx; x < bx + 16 && x < w; x++) world.SetCell(world.Index(x, y), WOOD);
+    world.SetCell(world.Index(bx + 8, std::max(by, 0)), FIRE);
+}
+
+//! Single-material scene: a walled box whose upper two thirds is a loose 50% fill of 'type'.
+//! 'sand' and 'water' use it to time the powder and liquid kernels on their own.
+static void BuildPourScene(World& world, int type) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int i = world.Index(x, y);
+
+            if (y >= h - 2 || x == 0 || x == w - 1) world.SetCell(i, WALL);
+            else if (y < 2 * h / 3 && Random::Range(0, 1) == 0) world.SetCell(i, type);
+        }
+    }
+}
+
+//! Walls on the floor and both sides
+static void BuildBox(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (y >= h - 2 || x == 0 || x == w - 1) world.SetCell(world.Index(x, y), WALL);
+        }
+    }
+}
+
+//! Full sand avalanche: a packed sand column over the left half collapses into a slope
+static void BuildAvalancheScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    for (int y = 0; y < h - 2; y++)
+        for (int x = 1; x < w / 2; x++) world.SetCell(world.Index(x, y), SAND);
+}
+
+//! Water tank sloshing: a dam of water over the left third breaks and sloshes across the tank
+static void BuildTankScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    for (int y = h / 4; y < h - 2; y++)
+        for (int x = 1; x < w / 3; x++) world.SetCell(world.Index(x, y), WATER);
+}
+
+//! Forest fire: a patchy wood forest over the lower two thirds, lit along its left edge
+static void BuildForestFireScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    for (int y = h / 3; y < h - 2; y++)
+        for (int x = 1; x < w - 1; x++)
+            if (Random::Range(0, 3) != 0) world.SetCell(world.Index(x, y), WOOD);
+
+    for (int y = h / 3; y < h - 2; y += 2) world.SetCell(world.Index(1, y), FIRE);
+}
+
+//! Lava meeting water: a lava pool and a water pool share the floor and touch in the middle
+static void BuildLavaWaterScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    for (int y = h / 2; y < h - 2; y++)
+        for (int x = 1; x < w - 1; x++) world.SetCell(world.Index(x, y), x < w / 2 ? LAVA : WATER);
+}
+
+//! Acid eating stone: an acid layer poured over a stone bed
+static void BuildAcidStoneScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    for (int y = h / 2; y < h - 2; y++)
+        for (int x = 1; x < w - 1; x++) world.SetCell(world.Index(x, y), y < 2 * h / 3 ? ACID : STONE);
+}
+
+//! Heat transport: a lava pocket sealed in the middle of a glass block (conducts well, never moves)
+static void BuildLavaPocketScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+    int r = std::max(w, h) / 16;
+    for (int y = h / 4; y < h - 2; y++) {
+        for (int x = 1; x < w - 1; x++) {
+            bool pocket = std::abs(x - w / 2) < r && std::abs(y - 5 * h / 8) < r;
+            world.SetCell(world.Index(x, y), pocket ? LAVA : GLASS);
+        }
+    }
+}
+
+//! Cooling: hot wall, stone and water blocks resting on the floor, nothing else going on.
+//! Every cell must end up back at ambient (dino_bench --expect-ambient).
+static void BuildCooldownScene(World& world) {
+    int w = world.GetWidth();
+    int h = world.GetHeight();
+    BuildBox(world);
+
+    const int types[3] = { WALL, STONE, WATER };
+    const float temps[3] = { 300.0f, 300.0f, 90.0f };
+    int size = std::max(std::min(w / 8, h / 4), 1);
+    for (int b = 0; b < 3; b++) {
+        int left = (2 * b + 1) * w / 6 - size / 2;
+        for (int y = h - 2 - size; y < h - 2; y++) {
+            for (int x = left; x < left + size; x++) {
+                int i = world.Index(x, y);
+                world.SetCell(i, types[b]);
+                world.SetTemp(i, temps[b]);
+            }
+        }
+    }
+}
+
+//! Idle world: all EMPTY (measures the fixed per-tick overhead)
+static void BuildIdleScene(World&) {}
+
+static void BuildSandPourScene(World& world) { BuildPourScene(world, SAND); }
+static void BuildWaterPourScene(World& world) { BuildPourScene(world, WATER); }
+
+const std::vector<SceneDef>& GetScenes() {
+    static const std::vector<SceneDef> scenes = {
+        //! Canonical suite
+        { "avalanche", "packed sand column collapsing", BuildAvalancheScene, true },
+        { "tank", "water dam breaking in a tank", BuildTankScene, true },
+        { "forest_fire", "fire spreading through wood", BuildForestFireScene, true },
+        { "lava_water", "lava pool meeting a water pool", BuildLavaWaterScene, true },
+        { "acid_stone", "acid layer over a stone bed", BuildAcidStoneScene, true },
+        { "idle", "empty world", BuildIdleScene, true },
+
+        //! Extra single-run scenes
+        { "mixed", "sand rain, water pool, burning wood, lava", BuildMixedScene, false },
+        { "settled", "packed sand bed with one small fire", BuildSettledScene, false },
+        { "sand", "loose 50% sand fill (powder kernel)", BuildSandPourScene, false },
+        { "water", "loose 50% water fill (liquid kernel)", BuildWaterPourScene, false },
+        { "lava_pocket", "lava pocket sealed in glass (heat transport)", BuildLavaPocketScene, false },
+        { "cooldown", "hot wall, stone and water blocks cooling to ambient", BuildCooldownScene, false },
+    };
+    return scenes;
+}
+
+const SceneDef* FindScene(const char* name) {
+    for (const SceneDef& s : GetScenes()) if (std::strcmp(s.name, name) == 0) return &s;
+    return nullptr;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <vector>
+#include "Simulation/World.h"
+
+//! Seeded benchmark scenes, built through the public World API.
+//! Builders draw with Random::Range, so call Random::Seed() first for a reproducible layout.
+struct SceneDef {
+    const char* name;
+    const char* description;
+    void (*build)(World& world);
+    bool inSuite;   //! Part of the canonical --suite run
+};
+
+//! Every scene, suite scenes first
+const std::vector<SceneDef>& GetScenes();
+
+//! nullptr if there is no scene called 'name'
+const SceneDef* FindScene(const char* name);
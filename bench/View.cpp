@@ -0,0 +1,139 @@
+//! dino_view: Headless viewer for frame streams written by dino_bench --emit (see FrameStream.h).
+//! Reconstructs every frame and prints its tick, size and state hash (compare with the hash the
+//! writer reports). --ppm writes every --every'th frame as PREFIX_TICK.ppm, colorized like the game
+//! (--thermal: heatmap); only the tiles a frame touched are recolorized.
+//! The source is a file, "-" for stdin (e.g. piped over ssh) or unix:PATH to listen on a local
+//! socket until a writer connects.
+//!
+//! Usage: dino_view SOURCE [--ppm PREFIX] [--every N] [--thermal] [--quiet]
+
+#include "Simulation/FrameStream.h"
+#include "Graphics/Colorizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct ViewOptions {
+    std::string source;
+    std::string ppm;        //! Image prefix ("" = no images)
+    int every = 1;
+    bool thermal = false;
+    bool quiet = false;     //! Summary only
+};
+
+static bool ParseArgs(int argc, char** argv, ViewOptions& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--ppm") == 0 && hasValue) opt.ppm = argv[++i];
+        else if (std::strcmp(arg, "--every") == 0 && hasValue) opt.every = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--thermal") == 0) opt.thermal = true;
+        else if (std::strcmp(arg, "--quiet") == 0) opt.quiet = true;
+        else if (arg[0] != '-' || std::strcmp(arg, "-") == 0) opt.source = arg;
+        else opt.source.clear(), i = argc;
+    }
+    if (opt.source.empty()) {
+        std::fprintf(stderr, "Usage: %s SOURCE [--ppm PREFIX] [--every N] [--thermal] [--quiet]\n", argv[0]);
+        std::fprintf(stderr, "       SOURCE: stream file, - (stdin) or unix:PATH (listen on a local socket)\n");
+        return false;
+    }
+    return true;
+}
+
+//! Binary PPM of RGBA8 pixels
+static bool WritePpm(const std::string& path, const std::vector<std::uint32_t>& pixels, int width, int height) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+    std::vector<std::uint8_t> row((std::size_t)width * 3);
+    bool ok = true;
+    for (int y = 0; y < height && ok; y++) {
+        const std::uint8_t* src = (const std::uint8_t*)(pixels.data() + (std::size_t)y * width);
+        for (int x = 0; x < width; x++) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        ok = std::fwrite(row.data(), 1, row.size(), f) == row.size();
+    }
+    return std::fclose(f) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    ViewOptions opt;
+    if (!ParseArgs(argc, argv, opt)) return 1;
+
+    std::FILE* in = FrameStream::OpenInput(opt.source);
+    FrameDecoder decoder;
+    if (!decoder.Open(in)) {
+        std::fprintf(stderr, "Cannot read a frame stream from '%s'\n", opt.source.c_str());
+        FrameStream::Close(in);
+        return 1;
+    }
+    int width = decoder.GetWidth(), height = decoder.GetHeight();
+    std::printf("stream        : %d x %d\n", width, height);
+
+    Colorizer colorizer;
+    std::vector<std::uint32_t> pixels(opt.ppm.empty() ? 0 : (size_t)width * height);
+    std::vector<PixelRect> dirtyRects;
+    std::uint32_t drawnEpoch = 0;
+
+    int frames = 0, keyFrames = 0, images = 0;
+    double bytes = 0.0, decodeMs = 0.0;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        if (!decoder.Next()) break;
+        decodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        GridView grid = decoder.GetView();
+        frames++;
+        keyFrames += decoder.IsKeyFrame();
+        bytes += decoder.GetFrameBytes() + 4.0;
+
+        //! Colorize as the frames come (noise and flicker follow the tick), write every N'th
+        if (!pixels.empty()) {
+            Colorizer::CollectChangedRects(grid, drawnEpoch, dirtyRects);
+            drawnEpoch = grid.changeEpoch;
+            for (const PixelRect& r : dirtyRects) {
+                colorizer.ColorizeRect(grid, opt.thermal, grid.tick, r.x0, r.y0, r.x1, r.y1, pixels.data() + (size_t)r.y0 * width + r.x0, width);
+            }
+            if ((frames - 1) % opt.every == 0) {
+                char path[32];
+                std::snprintf(path, sizeof(path), "_%06u.ppm", grid.tick);
+                if (!WritePpm(opt.ppm + path, pixels, width, height)) {
+                    std::fprintf(stderr, "Cannot write '%s%s'\n", opt.ppm.c_str(), path);
+                    FrameStream::Close(in);
+                    return 1;
+                }
+                images++;
+            }
+        }
+
+        if (!opt.quiet) {
+            std::printf("tick %-8u: %s %5d tiles %9u bytes  hash %016llx\n", grid.tick, decoder.IsKeyFrame() ? "key  " : "delta",
+                decoder.GetFrameTiles(), decoder.GetFrameBytes(), (unsigned long long)FrameStream::Hash(grid));
+        }
+    }
+    bool complete = decoder.IsEnded();
+    FrameStream::Close(in);
+
+    double frameBytes = (double)width * height * (sizeof(CellType) + sizeof(std::uint16_t));
+    std::printf("frames        : %d (%d key)\n", frames, keyFrames);
+    if (frames > 0) {
+        std::printf("last tick     : %u\n", decoder.GetTick());
+        std::printf("stream hash   : %016llx\n", (unsigned long long)FrameStream::Hash(decoder.GetView()));
+        std::printf("size          : %.1f KB/frame (%.2f%% of a full frame), decode %.4f ms/frame\n",
+            bytes / frames / 1024.0, 100.0 * bytes / frames / frameBytes, decodeMs / frames);
+    }
+    if (images > 0) std::printf("images        : %d (%s_*.ppm)\n", images, opt.ppm.c_str());
+    if (!complete) {
+        std::fprintf(stderr, "Stream ends with a truncated or corrupt frame\n");
+        return 1;
+    }
+    return 0;
+}
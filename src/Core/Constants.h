@@ -9,9 +9,19 @@ namespace Config {
 	//TODO Check all Res.
 	const int UI_HEIGHT = 80;       //! Height of the bottom UI panel (for buttons)
 	const int SIM_HEIGHT_PIXELS = SCREEN_HEIGHT - UI_HEIGHT; //! The actual play area height
-	const int SCALE = 4;            //! Scaling factor: 1 simulation cell = 4x4 screen pixels (Optimization)
+	const int SCALE = 4;            //! Default zoom: 1 simulation cell = 4x4 screen pixels
 
-	//! Calculated dimensions of the simulation grid based on the scale
+	//! Default grid size (fills the play area at SCALE); override with --width / --height.
+	//! The grid is independent of the window: larger worlds are panned and zoomed (see Viewport)
 	const int SIM_WIDTH = SCREEN_WIDTH / SCALE;
 	const int SIM_HEIGHT = SIM_HEIGHT_PIXELS / SCALE;
+
+	const float ZOOM_STEP = 1.25f;  //! Zoom factor per mouse wheel notch (Ctrl + wheel)
+	const float PAN_SPEED = 600.0f; //! Arrow key panning in screen pixels per second
+
+	const int TARGET_FPS = 60;      //! Frame cap; override with --fps (0 = uncapped)
+	const int TICK_RATE = 60;       //! Simulation ticks per second with --threaded; override with --tick-rate (0 = as fast as possible)
+
+	const char* const SNAPSHOT_FILE = "dino.snap"; //! Quick save (F5) / load (F9) file
+	const char* const PAGE_FILE = "dino.pages";    //! Swap file of --stream (removed on exit)
 }
@@ -0,0 +1,78 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(file); return false; }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = (const std::uint8_t*)view;
+    size = (std::size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    data = nullptr;
+    size = 0;
+    fileHandle = mappingHandle = nullptr;
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat st;
+    if (fstat(file, &st) != 0 || st.st_size == 0) { ::close(file); return false; }
+
+    void* view = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED) { ::close(file); return false; }
+
+    //! Snapshots are decoded front to back
+    madvise(view, (std::size_t)st.st_size, MADV_SEQUENTIAL);
+
+    fd = file;
+    data = (const std::uint8_t*)view;
+    size = (std::size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) munmap((void*)data, size);
+    if (fd >= 0) ::close(fd);
+    data = nullptr;
+    size = 0;
+    fd = -1;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//! Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows).
+//! Pages are read by the OS on first touch; the view stays valid until Close() or destruction.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //! Maps 'path'; false if it cannot be opened or is empty
+    bool Open(const std::string& path);
+    void Close();
+
+    const std::uint8_t* GetData() const { return data; }
+    std::size_t GetSize() const { return size; }
+
+private:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
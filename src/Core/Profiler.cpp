@@ -0,0 +1,62 @@
+#include "Profiler.h"
+#include <algorithm>
+
+static const char* const CHANNEL_NAMES[PROF_CHANNEL_COUNT] = {
+    "thermo_ms", "solids_ms", "gases_ms", "update_ms", "render_ms", "ui_ms",
+    "cells_moved", "reactions", "phase_changes", "active_cells", "heat_cells"
+};
+
+const char* Profiler::GetChannelName(ProfileChannel channel) {
+    return CHANNEL_NAMES[channel];
+}
+
+void Profiler::EndFrame(unsigned int tick) {
+    int slot = frames % HISTORY;
+    for (int ch = 0; ch < PROF_CHANNEL_COUNT; ch++) history[ch][slot] = current[ch];
+    frames++;
+
+    if (csv) {
+        std::fprintf(csv, "%u", tick);
+        for (int ch = 0; ch < PROF_CHANNEL_COUNT; ch++) std::fprintf(csv, ",%.6g", current[ch]);
+        std::fputc('\n', csv);
+    }
+
+    std::fill(current, current + PROF_CHANNEL_COUNT, 0.0);
+}
+
+Profiler::Stats Profiler::GetStats(ProfileChannel channel) const {
+    int count = std::min(frames, HISTORY);
+    if (count == 0) return Stats{ 0, 0, 0, 0 };
+
+    double sorted[HISTORY];
+    std::copy(history[channel], history[channel] + count, sorted);
+
+    Stats s;
+    s.last = history[channel][(frames - 1) % HISTORY];
+    s.min = *std::min_element(sorted, sorted + count);
+    double sum = 0.0;
+    for (int k = 0; k < count; k++) sum += sorted[k];
+    s.avg = sum / count;
+
+    //! Nearest-rank 99th percentile
+    int rank = std::min(count - 1, (int)(0.99 * count));
+    std::nth_element(sorted, sorted + rank, sorted + count);
+    s.p99 = sorted[rank];
+    return s;
+}
+
+bool Profiler::OpenCsv(const std::string& path) {
+    CloseCsv();
+    csv = std::fopen(path.c_str(), "w");
+    if (!csv) return false;
+
+    std::fprintf(csv, "tick");
+    for (int ch = 0; ch < PROF_CHANNEL_COUNT; ch++) std::fprintf(csv, ",%s", CHANNEL_NAMES[ch]);
+    std::fputc('\n', csv);
+    return true;
+}
+
+void Profiler::CloseCsv() {
+    if (csv) std::fclose(csv);
+    csv = nullptr;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+//! Adds the wall-clock time of its scope to 'target' (milliseconds)
+class ScopedTimer {
+public:
+    explicit ScopedTimer(double& target) : target(target), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { target += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    double& target;
+    std::chrono::steady_clock::time_point start;
+};
+
+//! Values the profiler tracks once per frame (one CSV column each)
+enum ProfileChannel {
+    PROF_THERMO = 0,        //! World phase 1 (ms)
+    PROF_SOLIDS,            //! World phase 2 (ms)
+    PROF_GASES,             //! World phase 3 (ms)
+    PROF_UPDATE,            //! Whole World::Update (ms)
+    PROF_RENDER,            //! Renderer::DrawSimulation (ms)
+    PROF_UI,                //! Renderer::DrawUI (ms)
+    PROF_CELLS_MOVED,       //! Counters of the last tick...
+    PROF_REACTIONS,
+    PROF_PHASE_CHANGES,
+    PROF_ACTIVE_CELLS,
+    PROF_HEAT_CELLS,
+    PROF_CHANNEL_COUNT
+};
+
+//! Rolling per-frame statistics and an optional CSV stream.
+//! Record() values during a frame, then EndFrame() commits them: cheap enough to run every frame.
+class Profiler {
+public:
+    //! Frames kept for the rolling statistics (4 s at 60 FPS)
+    static const int HISTORY = 240;
+
+    struct Stats {
+        double last, min, avg, p99;
+    };
+
+    Profiler() = default;
+    ~Profiler() { CloseCsv(); }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    //! Adds to a channel's value for the current frame
+    void Record(ProfileChannel channel, double value) { current[channel] += value; }
+
+    //! Commits the current frame (and writes its CSV row, tagged with 'tick')
+    void EndFrame(unsigned int tick);
+
+    //! Statistics over the last HISTORY frames
+    Stats GetStats(ProfileChannel channel) const;
+
+    static const char* GetChannelName(ProfileChannel channel);
+
+    //! Streams one row per frame to 'path' (header first); false if it cannot be created
+    bool OpenCsv(const std::string& path);
+    void CloseCsv();
+
+private:
+    double current[PROF_CHANNEL_COUNT] = {};
+    double history[PROF_CHANNEL_COUNT][HISTORY] = {};
+    int frames = 0; //! Frames committed so far (history holds min(frames, HISTORY))
+
+    FILE* csv = nullptr;
+};
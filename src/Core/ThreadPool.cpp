@@ -0,0 +1,62 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount) {
+    for (int i = 1; i < threadCount; i++) workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void ThreadPool::RunJobs() {
+    for (int i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1)) (*task)(i);
+}
+
+void ThreadPool::WorkerLoop() {
+    unsigned long long seen = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeCv.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+
+        lock.unlock();
+        RunJobs();
+        lock.lock();
+
+        if (--busyWorkers == 0) doneCv.notify_one();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0) return;
+
+    //! Not worth waking anyone
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &fn;
+        jobCount = count;
+        nextJob.store(0);
+        busyWorkers = (int)workers.size();
+        generation++;
+    }
+    wakeCv.notify_all();
+
+    //! The caller works too
+    RunJobs();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCv.wait(lock, [&] { return busyWorkers == 0; });
+    task = nullptr;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Minimal fork-join worker pool.
+//! ParallelFor() hands out indices to the workers and the calling thread, and returns once all are done.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+
+    //! Current batch (valid while a ParallelFor is running)
+    const std::function<void(int)>* task = nullptr;
+    int jobCount = 0;
+    std::atomic<int> nextJob{ 0 };
+
+    unsigned long long generation = 0; //! Bumped for every batch
+    int busyWorkers = 0;
+    bool stopping = false;
+
+    void WorkerLoop();
+    void RunJobs();
+
+public:
+    //! 'threadCount' includes the calling thread, so (threadCount - 1) workers are spawned
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int GetThreadCount() const { return (int)workers.size() + 1; }
+
+    //! Runs fn(i) for every i in [0, count) and blocks until all calls returned
+    void ParallelFor(int count, const std::function<void(int)>& fn);
+};
@@ -0,0 +1,194 @@
+#include "Colorizer.h"
+#include "Simulation/Random.h"
+#include <algorithm>
+
+//! Packs a color into the pixel layout (little-endian: R in the low byte)
+static std::uint32_t Pack(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+    return (std::uint32_t)r | ((std::uint32_t)g << 8) | ((std::uint32_t)b << 16) | ((std::uint32_t)a << 24);
+}
+
+static std::uint32_t Pack(ElementColor c) { return Pack(c.r, c.g, c.b, c.a); }
+
+//! Same rounding as the original per-pixel ColorLerp (result is opaque)
+static std::uint32_t Lerp(ElementColor c1, ElementColor c2, float amount) {
+    if (amount < 0) amount = 0;
+    if (amount > 1) amount = 1;
+    return Pack(
+        (unsigned char)(c1.r + amount * (c2.r - c1.r)),
+        (unsigned char)(c1.g + amount * (c2.g - c1.g)),
+        (unsigned char)(c1.b + amount * (c2.b - c1.b)),
+        255);
+}
+
+//! Blends two packed colors, weight 0..256 towards 'target'; the result is opaque
+static inline std::uint32_t Blend(std::uint32_t c, std::uint32_t target, std::uint32_t w) {
+    std::uint32_t inv = 256 - w;
+    std::uint32_t rb = (((c & 0x00FF00FFu) * inv + (target & 0x00FF00FFu) * w) >> 8) & 0x00FF00FFu;
+    std::uint32_t g = (((c & 0x0000FF00u) * inv + (target & 0x0000FF00u) * w) >> 8) & 0x0000FF00u;
+    return rb | g | 0xFF000000u;
+}
+
+namespace Palette {
+    const ElementColor BLACK  = { 0, 0, 0, 255 };
+    const ElementColor WHITE  = { 255, 255, 255, 255 };
+    const ElementColor ORANGE = { 255, 161, 0, 255 };
+    const ElementColor RED    = { 230, 41, 55, 255 };
+    const ElementColor LIME   = { 0, 158, 47, 255 };
+
+    //! Heat glow / cold tint targets
+    const ElementColor GLOW   = { 255, 100, 50, 255 };
+    const ElementColor FROST  = { 200, 200, 255, 255 };
+}
+
+//! Temperature at the center of a LUT entry
+static float LutTemp(int idx) {
+#ifdef DINO_COMPACT_TEMP
+    int shift = 16 - Colorizer::TEMP_LUT_BITS;
+    return DecodeTemp((CellTemp)((idx << shift) | (1 << (shift - 1))));
+#else
+    return MIN_TEMP + idx * ((MAX_TEMP - MIN_TEMP) / (Colorizer::TEMP_LUT_SIZE - 1));
+#endif
+}
+
+//! Heatmap palette (thermal vision)
+static std::uint32_t ThermalColor(float temp) {
+    const ElementColor cold = { 0, 0, 150, 255 };
+    const ElementColor ambient = { 0, 120, 255, 255 };
+    const ElementColor room = { 0, 255, 255, 255 };
+    const ElementColor warm = { 0, 255, 0, 255 };
+    const ElementColor hot = { 255, 255, 0, 255 };
+    const ElementColor fire = { 255, 0, 0, 255 };
+    const ElementColor plasma = { 255, 255, 255, 255 };
+
+    if (temp < 0.0f) return Pack(cold);
+    if (temp < 25.0f) return Lerp(ambient, room, temp / 25.0f);
+    if (temp < 100.0f) return Lerp(room, warm, (temp - 25.0f) / 75.0f);
+    if (temp < 400.0f) return Lerp(warm, hot, (temp - 100.0f) / 300.0f);
+    if (temp < 1000.0f) return Lerp(hot, fire, (temp - 400.0f) / 600.0f);
+    return Lerp(fire, plasma, (temp - 1000.0f) / 1000.0f);
+}
+
+Colorizer::Colorizer() {
+    for (int idx = 0; idx < TEMP_LUT_SIZE; idx++) {
+        float temp = LutTemp(idx);
+        thermalLut[idx] = ThermalColor(temp);
+
+        float glow = temp > 500.0f ? std::min((temp - 500.0f) / 1000.0f, 1.0f) * 0.8f : 0.0f;
+        float cold = temp < 0.0f ? std::min(-temp / 50.0f, 0.6f) : 0.0f;
+        glowWeight[idx] = (std::uint16_t)(glow * 256.0f + 0.5f);
+        coldWeight[idx] = (std::uint16_t)(cold * 256.0f + 0.5f);
+    }
+
+    for (int id = 0; id < ELEMENT_COUNT; id++) {
+        ElementColor base = GetElementColor(id);
+        int count = 1;
+        variants[id][0] = Pack(base);
+
+        //! Noise for liquid/gas visuals, picked per pixel by hash
+        if (id == ACIDIC_WATER) {
+            count = 21;
+            for (int k = 0; k < count; k++) variants[id][k] = Lerp(base, Palette::WHITE, (k - 10) / 100.0f);
+        }
+        else if (id == FIRE) {
+            count = 3;
+            for (int k = 0; k < count; k++) variants[id][k] = Pack(k == 0 ? Palette::ORANGE : Palette::RED);
+        }
+        else if (id == SAND) {
+            count = 6;
+            for (int k = 0; k < count; k++) variants[id][k] = Lerp(base, Palette::BLACK, k / 100.0f);
+        }
+        else if (id == ACID) {
+            count = 4;
+            for (int k = 0; k < count; k++) variants[id][k] = k == 0 ? Pack(Palette::LIME) : Pack(base);
+        }
+        variantCount[id] = count;
+
+        glows[id] = id != FIRE;
+        chills[id] = id != ICE;
+    }
+
+    //! Air is drawn black regardless of temperature
+    variants[EMPTY][0] = Pack(Palette::BLACK);
+    glows[EMPTY] = chills[EMPTY] = false;
+}
+
+void Colorizer::ColorizeRect(const GridView& view, bool thermal, unsigned int frame, int x0, int y0, int x1, int y1, std::uint32_t* pixels, int stride) const {
+    const CellType* grid = view.cells;
+    const CellTemp* gridTemp = view.temps;
+    int width = view.width;
+    const GridLayout& layout = view.layout;
+
+    const std::uint32_t glowColor = Pack(Palette::GLOW);
+    const std::uint32_t frostColor = Pack(Palette::FROST);
+    std::uint32_t frameKey = Random::Mix(frame * 0x9E3779B9u + 1u);
+
+    //! Blocks keep the temperature -> LUT index conversion in its own (vectorizable) loop
+    const int BLOCK = 256;
+    int lutIndex[BLOCK];
+
+    for (int y = y0; y < y1; y++) {
+        std::uint32_t* row = pixels + (size_t)(y - y0) * stride - x0;
+
+        //! Blocks never cross a tile edge, so their cells are contiguous
+        for (int blockX = x0, count; blockX < x1; blockX += count) {
+            count = std::min({ BLOCK, x1 - blockX, layout.RunLength(blockX) });
+            int blockStart = layout.Index(blockX, y);
+            int cellKey = y * width + blockX;   //! Noise follows the position, not the storage order
+            const CellType* types = grid + blockStart;
+            std::uint32_t* out = row + blockX;
+
+            for (int k = 0; k < count; k++) lutIndex[k] = TempIndex(gridTemp[blockStart + k]);
+
+            if (thermal) {
+                //! --- THERMAL MODE RENDER ---
+                for (int k = 0; k < count; k++) out[k] = thermalLut[lutIndex[k]];
+                continue;
+            }
+
+            //! --- STANDARD RENDER ---
+            for (int k = 0; k < count; k++) {
+                int type = types[k];
+                int t = lutIndex[k];
+
+                std::uint32_t c = variants[type][0];
+
+                //! Noisy elements pick a variant; one multiplicative hash is plenty for visual noise
+                if (variantCount[type] > 1) {
+                    std::uint32_t noise = ((std::uint32_t)(cellKey + k) ^ frameKey) * 0x9E3779B1u;
+                    c = variants[type][((std::uint64_t)noise * (std::uint32_t)variantCount[type]) >> 32];
+                }
+
+                //! Heat Glow / Cold Tint (rare: most cells sit near ambient)
+                if (glows[type] && glowWeight[t]) c = Blend(c, glowColor, glowWeight[t]);
+                else if (chills[type] && coldWeight[t]) c = Blend(c, frostColor, coldWeight[t]);
+
+                out[k] = c;
+            }
+        }
+    }
+}
+
+void Colorizer::CollectChangedRects(const GridView& view, std::uint32_t epoch, const PixelRect& clip, std::vector<PixelRect>& rects) {
+    const std::uint32_t* epochs = view.chunkEpochs;
+    const int shift = World::CHUNK_SHIFT;
+    const int size = World::CHUNK_SIZE;
+    int chunksX = view.chunksX;
+
+    rects.clear();
+    if (clip.x0 >= clip.x1 || clip.y0 >= clip.y1) return;
+
+    int cx0 = clip.x0 >> shift, cx1 = (clip.x1 - 1) >> shift;
+    for (int cy = clip.y0 >> shift; cy <= ((clip.y1 - 1) >> shift); cy++) {
+        int first = -1, last = -1;
+        for (int cx = cx0; cx <= cx1; cx++) {
+            if (epochs[cy * chunksX + cx] <= epoch) continue;
+            if (first < 0) first = cx;
+            last = cx;
+        }
+        if (first < 0) continue;
+
+        rects.push_back(PixelRect{
+            std::max(first * size, clip.x0), std::max(cy * size, clip.y0),
+            std::min((last + 1) * size, clip.x1), std::min((cy + 1) * size, clip.y1) });
+    }
+}
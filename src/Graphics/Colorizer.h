@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Simulation/World.h"
+#include "Simulation/GridView.h"
+
+//! Cell rectangle [x0, x1) x [y0, y1)
+struct PixelRect {
+    int x0, y0, x1, y1;
+
+    int Area() const { return (x1 - x0) * (y1 - y0); }
+};
+
+//! Turns grid state into RGBA8 pixels (byte order R, G, B, A; same layout as raylib's
+//! PIXELFORMAT_UNCOMPRESSED_R8G8B8A8). Free of raylib so it can be benchmarked headless.
+//! All colors come from tables built once in the constructor; the per-pixel work is a few
+//! lookups and at most one integer blend.
+class Colorizer {
+public:
+    //! Thermal palette resolution over MIN_TEMP..MAX_TEMP (~0.64 degrees per entry)
+    static const int TEMP_LUT_BITS = 13;
+    static const int TEMP_LUT_SIZE = 1 << TEMP_LUT_BITS;
+
+    //! Most noise variants an element can have
+    static const int MAX_VARIANTS = 21;
+
+    Colorizer();
+
+    //! Writes the cells [x0, x1) x [y0, y1) into 'pixels' (row-major, 'stride' pixels per row,
+    //! pixels[0] is cell (x0, y0)). 'frame' keys the animated noise (fire flicker, sand grain).
+    void ColorizeRect(const GridView& grid, bool thermal, unsigned int frame, int x0, int y0, int x1, int y1, std::uint32_t* pixels, int stride) const;
+
+    //! Regions of 'clip' that changed since change epoch 'epoch' (see World::GetChunkEpochs):
+    //! one rectangle per chunk row, spanning its leftmost to rightmost changed chunk, clipped to 'clip'.
+    //! Only the chunks under 'clip' are visited.
+    static void CollectChangedRects(const GridView& grid, std::uint32_t epoch, const PixelRect& clip, std::vector<PixelRect>& rects);
+
+    //! Whole grid
+    static void CollectChangedRects(const GridView& grid, std::uint32_t epoch, std::vector<PixelRect>& rects) {
+        CollectChangedRects(grid, epoch, PixelRect{ 0, 0, grid.width, grid.height }, rects);
+    }
+
+    //! Whole grid (stride = grid width)
+    void Colorize(const GridView& grid, bool thermal, unsigned int frame, std::uint32_t* pixels) const {
+        ColorizeRect(grid, thermal, frame, 0, 0, grid.width, grid.height, pixels, grid.width);
+    }
+
+private:
+    //! Temperature -> heatmap color
+    std::uint32_t thermalLut[TEMP_LUT_SIZE];
+
+    //! Temperature -> glow / cold tint blend (weight in 0..256, 0 = untouched)
+    std::uint16_t glowWeight[TEMP_LUT_SIZE];
+    std::uint16_t coldWeight[TEMP_LUT_SIZE];
+
+    //! Per-element colors: 'variantCount' entries picked by hash (1 = no noise)
+    std::uint32_t variants[ELEMENT_COUNT][MAX_VARIANTS];
+    int variantCount[ELEMENT_COUNT];
+    bool glows[ELEMENT_COUNT];  //! Tinted orange when hot (not FIRE)
+    bool chills[ELEMENT_COUNT]; //! Tinted blue when below zero (not ICE)
+
+    static int TempIndex(CellTemp t) {
+#ifdef DINO_COMPACT_TEMP
+        return t >> (16 - TEMP_LUT_BITS);
+#else
+        //! Clamped in float so the conversion stays branch-free
+        float f = (t - MIN_TEMP) * ((TEMP_LUT_SIZE - 1) / (MAX_TEMP - MIN_TEMP));
+        f = f < 0.0f ? 0.0f : f;
+        f = f > (float)(TEMP_LUT_SIZE - 1) ? (float)(TEMP_LUT_SIZE - 1) : f;
+        return (int)f;
+#endif
+    }
+};
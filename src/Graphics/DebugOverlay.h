@@ -2,34 +2,51 @@
 #define DEBUG_OVERLAY_H
 
 #include "raylib.h"
+#include "Viewport.h"
+#include "Core/Profiler.h"
 #include <string>
 
 //! Handles onscreen debug information and grid visualization
 class DebugOverlay {
 public:
-    bool isActive = false;
+    //! Pages cycled by Toggle()
+    enum Page { PAGE_OFF = 0, PAGE_CELL = 1, PAGE_PROFILER = 2, PAGE_COUNT = 3 };
 
-    void Toggle() { isActive = !isActive; }
+    int page = PAGE_OFF;
 
-    void Draw(int screenW, int screenH, int scale, int mouseX, int mouseY, int gridIndex, int cellType, float temp) {
-        if (!isActive) return;
+    void Toggle() { page = (page + 1) % PAGE_COUNT; }
 
-        //! Draw grid lines
-        for (int x = 0; x <= screenW; x += scale) DrawLine(x, 0, x, screenH, Fade(WHITE, 0.05f));
-        for (int y = 0; y <= screenH; y += scale) DrawLine(0, y, screenW, y, Fade(WHITE, 0.05f));
+    //! (cellX, cellY): cell under the mouse; gridIndex is -1 outside the world
+    void Draw(const Viewport& view, int mouseX, int mouseY, int cellX, int cellY, int gridIndex, int cellType, float temp, int uploadedBytes) {
+        if (page != PAGE_CELL) return;
 
-        int cellX = mouseX / scale;
-        int cellY = mouseY / scale;
+        int screenW = view.GetScreenWidth();
+        int screenH = view.GetScreenHeight();
+        float zoom = view.GetZoom();
 
-        if (mouseY < screenH) {
-            DrawRectangleLines(cellX * scale, cellY * scale, scale, scale, RED);
+        //! Draw grid lines (only when cells are large enough to tell apart)
+        if (zoom >= 4.0f) {
+            PixelRect visible = view.GetVisibleRect();
+            for (int x = visible.x0; x <= visible.x1; x++) {
+                int sx = (int)view.CellToScreenX((float)x);
+                DrawLine(sx, 0, sx, screenH, Fade(WHITE, 0.05f));
+            }
+            for (int y = visible.y0; y <= visible.y1; y++) {
+                int sy = (int)view.CellToScreenY((float)y);
+                DrawLine(0, sy, screenW, sy, Fade(WHITE, 0.05f));
+            }
+        }
+
+        if (mouseY < screenH && gridIndex >= 0) {
+            int size = std::max((int)zoom, 1);
+            DrawRectangleLines((int)view.CellToScreenX((float)cellX), (int)view.CellToScreenY((float)cellY), size, size, RED);
 
             //! Tooltip box
             int infoX = mouseX + 15;
             int infoY = mouseY + 15;
 
-            DrawRectangle(infoX, infoY, 160, 85, Fade(BLACK, 0.8f));
-            DrawRectangleLines(infoX, infoY, 160, 85, GREEN);
+            DrawRectangle(infoX, infoY, 160, 115, Fade(BLACK, 0.8f));
+            DrawRectangleLines(infoX, infoY, 160, 115, GREEN);
 
             DrawText(TextFormat("Grid X, Y: [%d, %d]", cellX, cellY), infoX + 5, infoY + 5, 10, GREEN);
             DrawText(TextFormat("Array Idx: %d", gridIndex), infoX + 5, infoY + 20, 10, GREEN);
@@ -38,6 +55,37 @@ public:
 
             //! Temperature readout
             DrawText(TextFormat("Temp: %.1f C", temp), infoX + 5, infoY + 65, 10, ORANGE);
+
+            //! Texture bytes uploaded this frame (changed chunks only)
+            DrawText(TextFormat("Upload: %.1f KB", uploadedBytes / 1024.0f), infoX + 5, infoY + 80, 10, SKYBLUE);
+
+            //! Camera
+            DrawText(TextFormat("Zoom: %.2fx", zoom), infoX + 5, infoY + 95, 10, LIGHTGRAY);
+        }
+    }
+
+    //! Profiler page: rolling last/min/avg/p99 of every channel
+    void DrawProfiler(const Profiler& profiler, int screenW) {
+        if (page != PAGE_PROFILER) return;
+
+        const int rowH = 14;
+        int boxW = 330;
+        int boxH = 30 + rowH * PROF_CHANNEL_COUNT;
+        int x = screenW - boxW - 10;
+        int y = 10;
+
+        DrawRectangle(x, y, boxW, boxH, Fade(BLACK, 0.8f));
+        DrawRectangleLines(x, y, boxW, boxH, GREEN);
+        DrawText(TextFormat("FPS: %d   (last %d frames)", GetFPS(), Profiler::HISTORY), x + 5, y + 5, 10, RED);
+        DrawText("channel              last       min       avg       p99", x + 5, y + 18, 10, LIGHTGRAY);
+
+        for (int ch = 0; ch < PROF_CHANNEL_COUNT; ch++) {
+            Profiler::Stats s = profiler.GetStats((ProfileChannel)ch);
+            int rowY = y + 32 + ch * rowH;
+            Color c = ch < PROF_CELLS_MOVED ? YELLOW : SKYBLUE; //! Timers / counters
+
+            DrawText(Profiler::GetChannelName((ProfileChannel)ch), x + 5, rowY, 10, c);
+            DrawText(TextFormat("%9.2f %9.2f %9.2f %9.2f", s.last, s.min, s.avg, s.p99), x + 110, rowY, 10, c);
         }
     }
 };
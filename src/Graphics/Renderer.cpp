@@ -2,113 +2,59 @@
 #include "Core/Constants.h"
 #include "Simulation/Elements.h"
 
-Renderer::Renderer(int w, int h) : simWidth(w), simHeight(h) {
-    simImage = GenImageColor(w, h, BLACK);
+Renderer::Renderer(int w, int h) {
+    Image simImage = GenImageColor(w, h, BLACK);
     texture = LoadTextureFromImage(simImage);
+    UnloadImage(simImage);
+
+    staging.resize((size_t)w * h);
 }
 
 Renderer::~Renderer() {
     UnloadTexture(texture);
-    UnloadImage(simImage);
 }
 
-//! Helper: Linear Interpolation for Colors
-static Color ColorLerp(Color c1, Color c2, float amount) {
-    if (amount < 0) amount = 0;
-    if (amount > 1) amount = 1;
-    return Color{
-        (unsigned char)(c1.r + amount * (c2.r - c1.r)),
-        (unsigned char)(c1.g + amount * (c2.g - c1.g)),
-        (unsigned char)(c1.b + amount * (c2.b - c1.b)),
-        255
-    };
+//! Helper: Simulation colors are raylib-free, convert them for drawing
+static Color ToColor(ElementColor c) {
+    return Color{ c.r, c.g, c.b, c.a };
 }
 
-void Renderer::DrawSimulation(const World& world) {
-    const std::vector<int>& grid = world.GetGridData();
-    const std::vector<float>& gridTemp = world.GetTempData();
-
-    for (int i = 0; i < (int)grid.size(); i++) {
-        Color c = BLACK;
-
-        if (thermalMode) {
-            //! --- THERMAL MODE RENDER ---
-            float temp = gridTemp[i];
+void Renderer::DrawSimulation(const GridView& grid, const Viewport& view) {
+    //! Visual noise is keyed by the frame, never by the simulation's random streams
+    frame++;
+    uploadedBytes = 0;
 
-            // Color Palette
-            Color c_cold = { 0, 0, 150, 255 };
-            Color c_ambient = { 0, 120, 255, 255 };
-            Color c_room = { 0, 255, 255, 255 };
-            Color c_warm = { 0, 255, 0, 255 };
-            Color c_hot = { 255, 255, 0, 255 };
-            Color c_fire = { 255, 0, 0, 255 };
-            Color c_plasma = { 255, 255, 255, 255 };
+    PixelRect visible = view.GetVisibleRect();
+    if (visible.x0 >= visible.x1 || visible.y0 >= visible.y1) return;
 
-            if (temp < 0.0f) {
-                c = c_cold;
-            }
-            else if (temp < 25.0f) {
-                float t = (temp - 0.0f) / 25.0f;
-                c = ColorLerp(c_ambient, c_room, t);
-            }
-            else if (temp < 100.0f) {
-                float t = (temp - 25.0f) / 75.0f;
-                c = ColorLerp(c_room, c_warm, t);
-            }
-            else if (temp < 400.0f) {
-                float t = (temp - 100.0f) / 300.0f;
-                c = ColorLerp(c_warm, c_hot, t);
-            }
-            else if (temp < 1000.0f) {
-                float t = (temp - 400.0f) / 600.0f;
-                c = ColorLerp(c_hot, c_fire, t);
-            }
-            else {
-                float t = (temp - 1000.0f) / 1000.0f;
-                if (t > 1.0f) t = 1.0f;
-                c = ColorLerp(c_fire, c_plasma, t);
-            }
-        }
-        else {
-            //! --- STANDARD RENDER ---
-            if (grid[i] != EMPTY) {
-                c = GetElementColor(grid[i]);
-                //! Add noise for liquid/gas visuals
-                if (grid[i] == ACIDIC_WATER) c = ColorLerp(c, WHITE, GetRandomValue(-10, 10) / 100.0f);
-                if (grid[i] == FIRE) c = (GetRandomValue(0, 2) == 0) ? ORANGE : RED;
-                if (grid[i] == SAND) c = ColorLerp(c, BLACK, GetRandomValue(0, 5) / 100.0f);
-                if (grid[i] == ACID) c = (GetRandomValue(0, 3) == 0) ? LIME : c;
+    bool viewMoved = visible.x0 != drawnView.x0 || visible.y0 != drawnView.y0 ||
+                     visible.x1 != drawnView.x1 || visible.y1 != drawnView.y1;
 
-
-                float temp = gridTemp[i];
-                //! Heat Glow
-                if (temp > 500.0f && grid[i] != FIRE) {
-                    float t = (temp - 500.0f) / 1000.0f;
-                    if (t > 1.0f) t = 1.0f;
-                    
-                    Color glowColor = { 255, 100, 50, 255 };
-               
-                    c = ColorLerp(c, glowColor, t * 0.8f);
-                }
-                //! Cold Tint
-                else if (temp < 0.0f && grid[i] != ICE) {
-                    float t = -temp / 50.0f;
-                    if (t > 0.6f) t = 0.6f;
-
-                    Color coldColor = { 200, 200, 255, 255 };
-                    c = ColorLerp(c, coldColor, t);
-                }
-            }
-        }
-        ImageDrawPixel(&simImage, i % simWidth, i / simWidth, c);
+    if (fullRedraw || viewMoved) {
+        dirtyRects.assign(1, visible);
+        drawnView = visible;
+        fullRedraw = false;
+    }
+    else {
+        //! Only the visible chunks that changed since the last frame
+        Colorizer::CollectChangedRects(grid, drawnEpoch, visible, dirtyRects);
     }
 
-    UpdateTexture(texture, simImage.data);
+    for (const PixelRect& r : dirtyRects) {
+        colorizer.ColorizeRect(grid, thermalMode, frame, r.x0, r.y0, r.x1, r.y1, staging.data(), r.x1 - r.x0);
+        UpdateTextureRec(texture, Rectangle{ (float)(r.x0 - visible.x0), (float)(r.y0 - visible.y0), (float)(r.x1 - r.x0), (float)(r.y1 - r.y0) }, staging.data());
+        uploadedBytes += r.Area() * (int)sizeof(std::uint32_t);
+    }
+    drawnEpoch = grid.changeEpoch;
 
+    float zoom = view.GetZoom();
+    BeginScissorMode(0, 0, view.GetScreenWidth(), view.GetScreenHeight());
     DrawTexturePro(texture,
-        Rectangle{ 0, 0, (float)simWidth, (float)simHeight },
-        Rectangle{ 0, 0, (float)Config::SCREEN_WIDTH, (float)Config::SIM_HEIGHT_PIXELS },
+        Rectangle{ 0, 0, (float)(visible.x1 - visible.x0), (float)(visible.y1 - visible.y0) },
+        Rectangle{ view.CellToScreenX((float)visible.x0), view.CellToScreenY((float)visible.y0),
+                   (visible.x1 - visible.x0) * zoom, (visible.y1 - visible.y0) * zoom },
         Vector2{ 0, 0 }, 0.0f, WHITE);
+    EndScissorMode();
 }
 
 void Renderer::DrawUI(int& currentTool) {
@@ -121,7 +67,7 @@ void Renderer::DrawUI(int& currentTool) {
     for (int i = 0; i < (int)elements.size(); i++) {
         int x = startX + (buttonW + 5) * i;
         if (elements[i].id == currentTool) DrawRectangleLines(x - 2, startY - 2, buttonW + 4, 44, WHITE);
-        DrawRectangle(x, startY, buttonW, 40, elements[i].color);
+        DrawRectangle(x, startY, buttonW, 40, ToColor(elements[i].color));
         DrawText(elements[i].name.c_str(), x + 5, startY + 15, 10, (elements[i].id == EMPTY || elements[i].id == SAND) ? WHITE : BLACK);
 
         Vector2 m = GetMousePosition();
@@ -1,27 +1,50 @@
 #pragma once
 #include "raylib.h"
+#include <cstdint>
+#include <vector>
 #include "Simulation/World.h"
+#include "Colorizer.h"
+#include "Viewport.h"
 
 class Renderer {
 private:
-    Image simImage;
+    //! Holds the visible region only: texel (0, 0) is cell (drawnView.x0, drawnView.y0)
     Texture2D texture;
-    int simWidth;
-    int simHeight;
+
+    //! Pixels of the region being uploaded (RGBA8, one pixel per cell)
+    std::vector<std::uint32_t> staging;
+    Colorizer colorizer;
+
+    //! Partial uploads: only chunks whose epoch is newer than the last drawn one are recolored
+    std::uint32_t drawnEpoch = 0;
+    bool fullRedraw = true;
+    int uploadedBytes = 0;
+    std::vector<PixelRect> dirtyRects;
+
+    //! World region currently in the texture; moving the view redraws it
+    PixelRect drawnView = { 0, 0, 0, 0 };
 
     //! Flag for Thermal Vision mode
     bool thermalMode = false;
 
+    //! Frame counter keying the visual noise
+    unsigned int frame = 0;
+
 public:
-    Renderer(int w, int h);
+    //! 'maxViewW' x 'maxViewH': largest visible region in cells (see Viewport::GetMaxVisibleWidth)
+    Renderer(int maxViewW, int maxViewH);
     ~Renderer();
 
     //! Toggles heatmap rendering
-    void ToggleThermalMode() { thermalMode = !thermalMode; }
+    void ToggleThermalMode() { thermalMode = !thermalMode; fullRedraw = true; }
     bool IsThermalMode() const { return thermalMode; }
 
-    //! Renders the simulation grid to the texture
-    void DrawSimulation(const World& world);
+    //! Renders the part of the grid inside the viewport (recoloring and uploading changed chunks only).
+    //! The cost follows the visible region, not the world size.
+    void DrawSimulation(const GridView& grid, const Viewport& view);
+
+    //! Texture bytes sent to the GPU by the last DrawSimulation()
+    int GetUploadedBytes() const { return uploadedBytes; }
 
     //! Renders the UI toolbar
     void DrawUI(int& currentTool);
@@ -0,0 +1,92 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include "Colorizer.h"
+
+//! Camera over the world: maps the simulation area of the window to a region of the grid.
+//! 'zoom' is screen pixels per cell; (offsetX, offsetY) is the cell coordinate at the top-left
+//! corner of the screen area. Free of raylib so the math can be used headless.
+class Viewport {
+public:
+    //! Closest zoom (screen pixels per cell)
+    static constexpr float MAX_ZOOM = 32.0f;
+
+    Viewport(int worldW, int worldH, int screenW, int screenH)
+        : worldW(worldW), worldH(worldH), screenW(screenW), screenH(screenH) {
+        //! Zoomed all the way out, small worlds fill the screen and large ones show one cell per pixel:
+        //! the visible region (and so the render cost) never exceeds the screen in cells
+        float fit = std::min((float)screenW / worldW, (float)screenH / worldH);
+        minZoom = std::min(std::max(fit, 1.0f), MAX_ZOOM);
+        zoom = minZoom;
+        Clamp();
+    }
+
+    float GetZoom() const { return zoom; }
+    float GetMinZoom() const { return minZoom; }
+    int GetScreenWidth() const { return screenW; }
+    int GetScreenHeight() const { return screenH; }
+
+    //! True if the screen point lies in the simulation area
+    bool ContainsScreen(float sx, float sy) const { return sx >= 0 && sy >= 0 && sx < screenW && sy < screenH; }
+
+    //! Cell under a screen point (may lie outside the world)
+    void ScreenToCell(float sx, float sy, int& cx, int& cy) const {
+        cx = (int)std::floor(offsetX + sx / zoom);
+        cy = (int)std::floor(offsetY + sy / zoom);
+    }
+
+    //! Screen position of a cell corner
+    float CellToScreenX(float cx) const { return (cx - offsetX) * zoom; }
+    float CellToScreenY(float cy) const { return (cy - offsetY) * zoom; }
+
+    //! Moves the picture by (dx, dy) screen pixels (right-drag, arrow keys)
+    void Pan(float dx, float dy) {
+        offsetX -= dx / zoom;
+        offsetY -= dy / zoom;
+        Clamp();
+    }
+
+    //! Multiplies the zoom, keeping the cell under the screen point (sx, sy) in place
+    void ZoomAt(float sx, float sy, float factor) {
+        float cellX = offsetX + sx / zoom;
+        float cellY = offsetY + sy / zoom;
+
+        zoom = std::min(std::max(zoom * factor, minZoom), MAX_ZOOM);
+        offsetX = cellX - sx / zoom;
+        offsetY = cellY - sy / zoom;
+        Clamp();
+    }
+
+    //! Cells at least partly on screen, clipped to the world
+    PixelRect GetVisibleRect() const {
+        return PixelRect{
+            std::max((int)std::floor(offsetX), 0),
+            std::max((int)std::floor(offsetY), 0),
+            std::min((int)std::ceil(offsetX + screenW / zoom), worldW),
+            std::min((int)std::ceil(offsetY + screenH / zoom), worldH) };
+    }
+
+    //! Upper bound of GetVisibleRect() over every zoom and position (texture size)
+    int GetMaxVisibleWidth() const { return std::min((int)std::ceil(screenW / minZoom) + 1, worldW); }
+    int GetMaxVisibleHeight() const { return std::min((int)std::ceil(screenH / minZoom) + 1, worldH); }
+
+private:
+    int worldW, worldH;
+    int screenW, screenH;
+    float zoom = 1.0f;
+    float minZoom = 1.0f;
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+
+    //! Keeps the world on screen; an axis narrower than the screen is centered
+    void Clamp() {
+        float viewW = screenW / zoom;
+        float viewH = screenH / zoom;
+
+        if (viewW >= worldW) offsetX = (worldW - viewW) * 0.5f;
+        else offsetX = std::min(std::max(offsetX, 0.0f), worldW - viewW);
+
+        if (viewH >= worldH) offsetY = (worldH - viewH) * 0.5f;
+        else offsetY = std::min(std::max(offsetY, 0.0f), worldH - viewH);
+    }
+};
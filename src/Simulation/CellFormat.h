@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include "Elements.h"
+#include "Random.h"
+
+//! Storage format of a grid cell.
+//! Element IDs always fit a byte. Temperatures are 32-bit floats by default; building with
+//! DINO_COMPACT_TEMP stores them as 16-bit fixed point instead (3 bytes per cell with the ID).
+
+using CellType = std::uint8_t;
+static_assert(ELEMENT_COUNT <= 256, "Element IDs must fit CellType");
+
+const float MIN_TEMP = -273.0f;     //! Absolute zero
+const float MAX_TEMP = 5000.0f;     //! Safety clamp
+
+#ifdef DINO_COMPACT_TEMP
+
+using CellTemp = std::uint16_t;
+
+//! Codes per degree: the clamp range maps onto 0..65535 (one step is ~0.08 degrees)
+const float TEMP_SCALE = 65535.0f / (MAX_TEMP - MIN_TEMP);
+
+inline CellTemp EncodeTemp(float t) {
+    if (t < MIN_TEMP) t = MIN_TEMP;
+    if (t > MAX_TEMP) t = MAX_TEMP;
+    return (CellTemp)((t - MIN_TEMP) * TEMP_SCALE + 0.5f);
+}
+
+//! Stochastic rounding: changes smaller than one step still add up over many ticks
+//! (slow cooling would otherwise stall a fraction of a degree above ambient)
+inline CellTemp EncodeTempDithered(float t) {
+    if (t < MIN_TEMP) t = MIN_TEMP;
+    if (t > MAX_TEMP) t = MAX_TEMP;
+    float noise = (Random::Next() >> 8) * (1.0f / 16777216.0f);
+    float code = (t - MIN_TEMP) * TEMP_SCALE + noise;
+    return (CellTemp)(code < 65535.0f ? code : 65535.0f);
+}
+
+inline float DecodeTemp(CellTemp t) {
+    return MIN_TEMP + t * (1.0f / TEMP_SCALE);
+}
+
+#else
+
+using CellTemp = float;
+
+inline CellTemp EncodeTemp(float t) { return t; }
+inline CellTemp EncodeTempDithered(float t) { return t; }
+inline float DecodeTemp(CellTemp t) { return t; }
+
+#endif
@@ -0,0 +1,53 @@
+#include "CoarseHeat.h"
+#include <algorithm>
+
+CoarseHeat::CoarseHeat(int bx, int by) : blocksX(bx), blocksY(by) {
+    temp.assign((std::size_t)bx * by, 0.0f);
+    cond.assign((std::size_t)bx * by, 0.0f);
+    fineRight.assign((std::size_t)bx * by, 0.0f);
+    fineDown.assign((std::size_t)bx * by, 0.0f);
+    pending.assign((std::size_t)bx * by, 0.0f);
+}
+
+void CoarseHeat::Reset(const float* values) {
+    if (values) pending.assign(values, values + pending.size());
+    else std::fill(pending.begin(), pending.end(), 0.0f);
+    primed = false;
+}
+
+//! Conductance between two blocks: harmonic mean, so an insulating block blocks the flow
+static inline float FaceConductance(float a, float b) {
+    return a + b > 0.0f ? 2.0f * a * b / (a + b) : 0.0f;
+}
+
+//! What a face adds to the cells' own flow 'fine': the part of 'coarse' beyond it, never
+//! against it and never more than 'coarse'
+static inline float Residual(float coarse, float fine) {
+    return coarse > 0.0f ? std::min(std::max(coarse - fine, 0.0f), coarse)
+                         : std::max(std::min(coarse - fine, 0.0f), coarse);
+}
+
+void CoarseHeat::Step(std::vector<float>& delta) const {
+    //! One explicit step over the whole interval: RATE * INTERVAL * 4 faces * conductivity <= 1 stays
+    //! well inside the stable range
+    const float k = RATE * INTERVAL;
+    delta.assign(temp.size(), 0.0f);
+
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            int b = by * blocksX + bx;
+
+            //! Each face once (right and down), applied to both sides: heat is conserved
+            if (bx + 1 < blocksX) {
+                float flow = Residual(k * FaceConductance(cond[b], cond[b + 1]) * (temp[b + 1] - temp[b]), fineRight[b]);
+                delta[b] += flow;
+                delta[b + 1] -= flow;
+            }
+            if (by + 1 < blocksY) {
+                float flow = Residual(k * FaceConductance(cond[b], cond[b + blocksX]) * (temp[b + blocksX] - temp[b]), fineDown[b]);
+                delta[b] += flow;
+                delta[b + blocksX] -= flow;
+            }
+        }
+    }
+}
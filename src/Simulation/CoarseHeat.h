@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//! Block level of the hierarchical thermal mode (World::SetCoarseHeat).
+//!
+//! Cell-to-cell diffusion moves heat about one cell per tick, so a lava pool takes thousands of
+//! ticks to warm anything a few chunks away. This level keeps one block per chunk (its mean
+//! temperature and conductivity) and exchanges heat between neighboring blocks every INTERVAL
+//! ticks. The World reconciles it with the cells:
+//!  - restriction: blocks are re-averaged from their cells only when their chunk changed;
+//!  - residual: cell diffusion already carries heat across each block face, so a face only
+//!    passes what the block gradient asks for beyond that (nothing where the cells keep up);
+//!  - prolongation: a block's change is collected in 'pending' and handed to its cells once it
+//!    reaches EPSILON, in proportion to their conductivity (insulators take little). Whatever
+//!    the cells could not take (clamping, rounding to the temperature encoding) stays pending,
+//!    so the exchange neither creates nor destroys heat. Only cells whose stored temperature
+//!    changed are woken.
+//! The block step is serial and draws no random numbers, so runs with it stay deterministic.
+class CoarseHeat {
+public:
+    static const int INTERVAL = 4;              //! Ticks per block step
+    static constexpr float RATE = 0.002f;       //! Block-to-block exchange per tick and unit of conductivity
+
+    //! Block change (degrees) a block collects before it is handed to the cells: far blocks
+    //! stay asleep while small trickles add up. Must stay above one step of the compact
+    //! temperature encoding (~0.08 degrees), or the cells would round it away.
+    static constexpr float EPSILON = 1.0f;
+
+    CoarseHeat(int blocksX, int blocksY);
+
+    //! Block averages, indexed like the World's chunks
+    std::vector<float> temp;
+    std::vector<float> cond;
+
+    //! Block mean change carried by cell diffusion over one interval across the right and bottom
+    //! face of each block (positive = into the block); filled by the World before Step()
+    std::vector<float> fineRight;
+    std::vector<float> fineDown;
+
+    //! Block change not yet handed to the cells
+    std::vector<float> pending;
+
+    //! World change epoch of the last restriction; blocks of chunks changed since are re-averaged
+    std::uint32_t epoch = 0;
+    bool primed = false;    //! False until every block has been averaged once
+
+    //! Exchanges INTERVAL ticks' worth of heat between neighboring blocks, less what cell
+    //! diffusion carries across the same faces. Writes the temperature change of every block
+    //! to 'delta' (it sums to zero); 'temp' is left as it is.
+    void Step(std::vector<float>& delta) const;
+
+    //! Forgets the block averages (re-averaged from the cells at the next step) and sets
+    //! 'pending' to 'values', one per block (nullptr = nothing pending)
+    void Reset(const float* values = nullptr);
+
+private:
+    int blocksX, blocksY;
+};
@@ -1,37 +1,51 @@
 #include "Elements.h"
 
+//! raylib palette values used by the registry (duplicated to avoid a raylib dependency)
+namespace Palette {
+    const ElementColor BLACK    = { 0, 0, 0, 255 };
+    const ElementColor DARKGRAY = { 80, 80, 80, 255 };
+    const ElementColor GOLD     = { 255, 203, 0, 255 };
+    const ElementColor SKYBLUE  = { 102, 191, 255, 255 };
+    const ElementColor BROWN    = { 127, 106, 79, 255 };
+    const ElementColor ORANGE   = { 255, 161, 0, 255 };
+    const ElementColor LIME     = { 0, 158, 47, 255 };
+    const ElementColor RAYWHITE = { 245, 245, 245, 255 };
+    const ElementColor RED      = { 230, 41, 55, 255 };
+    const ElementColor BLUE     = { 0, 121, 241, 255 };
+}
+
 //! Registry of all elements
 //! Format: { ID, NAME, COLOR, STATE, BASE_TEMP, CONDUCTIVITY, COOLING_RATE, HIGH_T, HIGH_CONV, LOW_T, LOW_CONV, FLAMMABILITY }
 std::vector<ElementDef> elements = {
     //! 0: AIR
-    { EMPTY, "AIR", BLACK, STATE_GAS, 22.0f, 0.4f, 0.01f, 9999.0f, -1, -9999.0f, -1, 0.0f },
+    { EMPTY, "AIR", Palette::BLACK, STATE_GAS, 22.0f, 0.4f, 0.01f, 9999.0f, -1, -9999.0f, -1, 0.0f },
 
     //! 1: WALL
-    { WALL, "WALL", DARKGRAY, STATE_STATIC, 22.0f, 0.05f, 0.0005f, 9999.0f, -1, -9999.0f, -1, 0.0f },
+    { WALL, "WALL", Palette::DARKGRAY, STATE_STATIC, 22.0f, 0.05f, 0.0005f, 9999.0f, -1, -9999.0f, -1, 0.0f },
 
     //! 2: SAND
-    { SAND, "SAND", GOLD, STATE_POWDER, 22.0f, 1.0f, 0.0008f, 1700.0f, GLASS, -9999.0f, -1, 0.0f },
+    { SAND, "SAND", Palette::GOLD, STATE_POWDER, 22.0f, 1.0f, 0.0008f, 1700.0f, GLASS, -9999.0f, -1, 0.0f },
 
     //! 3: WATER
-    { WATER, "WATER", SKYBLUE, STATE_LIQUID, 20.0f, 0.4f, 0.001f, 100.0f, STEAM, 0.0f, ICE, 0.0f },
+    { WATER, "WATER", Palette::SKYBLUE, STATE_LIQUID, 20.0f, 0.4f, 0.001f, 100.0f, STEAM, 0.0f, ICE, 0.0f },
 
     //! 4: WOOD
-    { WOOD, "WOOD", BROWN, STATE_STATIC, 22.0f, 0.1f, 0.01f, 300.0f, FIRE, -9999.0f, -1, 0.4f },
+    { WOOD, "WOOD", Palette::BROWN, STATE_STATIC, 22.0f, 0.1f, 0.01f, 300.0f, FIRE, -9999.0f, -1, 0.4f },
 
     //! 5: FIRE
-    { FIRE, "FIRE", ORANGE, STATE_GAS, 1200.0f, 0.8f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f },
+    { FIRE, "FIRE", Palette::ORANGE, STATE_GAS, 1200.0f, 0.8f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f },
 
     //! 6: SMOKE
     { SMOKE, "SMOKE", {150,150,150,180}, STATE_GAS, 600.0f, 0.3f, 0.05f, 9999.0f, -1, -9999.0f, -1, 0.0f },
 
     //! 7: ACID
-    { ACID, "ACID", LIME, STATE_LIQUID, 20.0f, 0.4f, 0.02f, 120.0f, STEAM, -9999.0f, -1, 0.1f },
+    { ACID, "ACID", Palette::LIME, STATE_LIQUID, 20.0f, 0.4f, 0.02f, 120.0f, STEAM, -9999.0f, -1, 0.1f },
 
     //! 8: ACIDIC_WATER
     { ACIDIC_WATER, "A.WATER", {0,240,200,200}, STATE_LIQUID, 25.0f, 0.4f, 0.02f, 110.0f, STEAM, -9999.0f, -1, 0.0f },
 
     //! 9: STEAM
-    { STEAM, "STEAM", RAYWHITE, STATE_GAS, 150.0f, 0.2f, 0.1f, 9999.0f, -1, 99.0f, WATER, 0.0f },
+    { STEAM, "STEAM", Palette::RAYWHITE, STATE_GAS, 150.0f, 0.2f, 0.1f, 9999.0f, -1, 99.0f, WATER, 0.0f },
 
     //! 10: ICE
     { ICE, "ICE", {200, 200, 255, 255}, STATE_STATIC, -10.0f, 0.3f, 0.01f, 1.0f, WATER, -9999.0f, -1, 0.0f },
@@ -40,7 +54,7 @@ std::vector<ElementDef> elements = {
     { LAVA, "LAVA", {255, 80, 0, 255}, STATE_LIQUID, 1200.0f, 0.5f, 0.005f, 9999.0f, -1, 700.0f, STONE, 0.0f },
 
     //! 12: STONE
-    { STONE, "STONE", DARKGRAY, STATE_STATIC, 22.0f, 0.05f, 0.002f, 1100.0f, LAVA, -9999.0f, -1, 0.0f },
+    { STONE, "STONE", Palette::DARKGRAY, STATE_STATIC, 22.0f, 0.05f, 0.002f, 1100.0f, LAVA, -9999.0f, -1, 0.0f },
 
     //! 13: GLASS
     { GLASS, "GLASS", {200, 255, 255, 150}, STATE_STATIC, 22.0f, 1.0f, 0.005f, 9999.0f, -1, -9999.0f, -1, 0.0f },
@@ -49,23 +63,39 @@ std::vector<ElementDef> elements = {
     { GUNPOWDER, "GUNPOWDER", {50, 50, 50, 255}, STATE_POWDER, 22.0f, 0.2f, 0.01f, 250.0f, FIRE, -9999.0f, -1, 0.9f },
 
     //! HEAT TOOL
-    { TOOL_HEAT, "HEAT", RED, STATE_STATIC, 0.0f, 0.0f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f },
+    { TOOL_HEAT, "HEAT", Palette::RED, STATE_STATIC, 0.0f, 0.0f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f },
 
     //! COOL TOOL
-    { TOOL_COOL, "COOL", BLUE, STATE_STATIC, 0.0f, 0.0f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f }
+    { TOOL_COOL, "COOL", Palette::BLUE, STATE_STATIC, 0.0f, 0.0f, 0.0f, 9999.0f, -1, -9999.0f, -1, 0.0f }
 };
 
-Color GetElementColor(int id) {
-    for (const auto& e : elements) if (e.id == id) return e.color;
-    return BLACK;
+//! Builds the dense table from the registry (tools are skipped)
+static ElementTable BuildElementTable() {
+    ElementTable table = {};
+    for (int id = 0; id < ELEMENT_COUNT; id++) table.def[id] = &elements[0];
+
+    for (const ElementDef& e : elements) {
+        if (!IsSimElement(e.id)) continue;
+
+        table.state[e.id] = (unsigned char)e.state;
+        table.baseTemp[e.id] = e.baseTemp;
+        table.conductivity[e.id] = e.heatConductivity;
+        table.coolingRate[e.id] = e.coolingRate;
+        table.highTemp[e.id] = e.highTemp;
+        table.highTempConvert[e.id] = e.highTempConvert;
+        table.lowTemp[e.id] = e.lowTemp;
+        table.lowTempConvert[e.id] = e.lowTempConvert;
+        table.flammability[e.id] = e.flammability;
+        table.color[e.id] = e.color;
+        table.def[e.id] = &e;
+    }
+    return table;
 }
 
-std::string GetElementName(int id) {
-    for (const auto& e : elements) if (e.id == id) return e.name;
-    return "AIR";
-}
+//! Must be defined after 'elements' (same translation unit, initialized in order)
+const ElementTable elementTable = BuildElementTable();
 
-const ElementDef& GetElementDef(int id) {
+const ElementDef& FindElementDef(int id) {
     for (const auto& e : elements) if (e.id == id) return e;
     return elements[0];
 }
\ No newline at end of file
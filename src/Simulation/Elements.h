@@ -1,5 +1,4 @@
 #pragma once
-#include "raylib.h"
 #include <string>
 #include <vector>
 
@@ -20,10 +19,16 @@ enum ElementType {
     STONE = 12,
     GLASS = 13,
     GUNPOWDER = 14,
+    ELEMENT_COUNT = 15,     //! Number of simulation elements (IDs 0 .. ELEMENT_COUNT - 1)
     TOOL_HEAT = 98,
     TOOL_COOL = 99
 };
 
+//! Plain RGBA color (kept free of raylib so the simulation builds headless)
+struct ElementColor {
+    unsigned char r, g, b, a;
+};
+
 //! Physical states of matter for generic physics logic
 enum ElementState {
     STATE_STATIC = 0,  //! Walls, Wood, Ice (Immovable)
@@ -36,7 +41,7 @@ enum ElementState {
 struct ElementDef {
     int id;                 //! Unique ID
     std::string name;       //! Display name for UI
-    Color color;            //! Base render color
+    ElementColor color;     //! Base render color
 
     //! --- Physics Properties ---
     int state;              //! Physical state (Solid, Liquid, Gas)
@@ -54,10 +59,44 @@ struct ElementDef {
     float flammability;     //! Probability of catching fire (0.0 = Non-flammable)
 };
 
+//! Dense, ID-indexed copy of the registry for the hot loops.
+//! Frequently used properties live in parallel arrays; tool IDs are not part of the table.
+struct ElementTable {
+    unsigned char state[ELEMENT_COUNT];
+    float baseTemp[ELEMENT_COUNT];
+    float conductivity[ELEMENT_COUNT];
+    float coolingRate[ELEMENT_COUNT];
+    float highTemp[ELEMENT_COUNT];
+    int highTempConvert[ELEMENT_COUNT];
+    float lowTemp[ELEMENT_COUNT];
+    int lowTempConvert[ELEMENT_COUNT];
+    float flammability[ELEMENT_COUNT];
+    ElementColor color[ELEMENT_COUNT];
+
+    const ElementDef* def[ELEMENT_COUNT]; //! Full definition (cold data: name, etc.)
+};
+
 //! Global access to the element registry
 extern std::vector<ElementDef> elements;
 
+//! Compiled from 'elements' at startup
+extern const ElementTable elementTable;
+
+//! True for IDs that can live in the simulation grid (excludes tools)
+inline bool IsSimElement(int id) { return (unsigned int)id < (unsigned int)ELEMENT_COUNT; }
+
+//! Registry lookup for IDs outside the table (tools); falls back to AIR
+const ElementDef& FindElementDef(int id);
+
 //! Helper functions
-Color GetElementColor(int id);
-std::string GetElementName(int id);
-const ElementDef& GetElementDef(int id);
\ No newline at end of file
+inline const ElementDef& GetElementDef(int id) {
+    if (IsSimElement(id)) return *elementTable.def[id];
+    return FindElementDef(id);
+}
+
+inline ElementColor GetElementColor(int id) {
+    if (IsSimElement(id)) return elementTable.color[id];
+    return FindElementDef(id).color;
+}
+
+inline const std::string& GetElementName(int id) { return GetElementDef(id).name; }
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "FrameStream.h"
+#include "World.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static_assert(FrameStream::TILE_SIZE == World::CHUNK_SIZE, "Stream tiles are the World's chunks");
+
+//! On-stream header (written as-is, little-endian like Snapshot)
+struct StreamHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t width, height;
+    std::uint32_t tileShift;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(StreamHeader) == 24, "StreamHeader layout changed");
+
+static const std::uint8_t FLAG_KEY = 1;
+
+//! Same 16-bit temperature codes as Snapshot (and the in-memory format of DINO_COMPACT_TEMP)
+static const float QUANT_SCALE = 65535.0f / (MAX_TEMP - MIN_TEMP);
+
+static std::uint16_t QuantizeTemp(CellTemp t) {
+#ifdef DINO_COMPACT_TEMP
+    return t;
+#else
+    float v = std::min(std::max(t, MIN_TEMP), MAX_TEMP);
+    return (std::uint16_t)((v - MIN_TEMP) * QUANT_SCALE + 0.5f);
+#endif
+}
+
+static CellTemp DequantizeTemp(std::uint16_t q) {
+#ifdef DINO_COMPACT_TEMP
+    return q;
+#else
+    return MIN_TEMP + q * (1.0f / QUANT_SCALE);
+#endif
+}
+
+//! --- VARINTS (LEB128) ---
+static void PutVarint(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((std::uint8_t)v);
+}
+
+static bool GetVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        std::uint8_t b = *p++;
+        v |= (std::uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static std::uint32_t ZigZag(std::int32_t v) { return ((std::uint32_t)v << 1) ^ (std::uint32_t)(v >> 31); }
+static std::int32_t UnZigZag(std::uint32_t v) { return (std::int32_t)(v >> 1) ^ -(std::int32_t)(v & 1); }
+
+//! Array indexes of the cells of tile (tx, ty), row-major within the tile
+static void TileIndexes(const GridLayout& layout, int tx, int ty, std::vector<int>& out) {
+    int x0 = tx << FrameStream::TILE_SHIFT, y0 = ty << FrameStream::TILE_SHIFT;
+    int w = std::min(FrameStream::TILE_SIZE, layout.width - x0);
+    int h = std::min(FrameStream::TILE_SIZE, layout.height - y0);
+    out.resize((std::size_t)w * h);
+    for (int y = 0; y < h; y++) {
+        int* row = out.data() + (std::size_t)y * w;
+        layout.ForEachRun(x0, y0 + y, w, [&](int index, int offset, int length) {
+            for (int k = 0; k < length; k++) row[offset + k] = index + k;
+        });
+    }
+}
+
+namespace FrameStream {
+
+std::FILE* OpenOutput(const std::string& target) {
+#ifndef _WIN32
+    //! A viewer that goes away must fail the write, not end the simulation
+    if (target == "-" || target.compare(0, 5, "unix:") == 0) std::signal(SIGPIPE, SIG_IGN);
+
+    if (target.compare(0, 5, "unix:") == 0) {
+        std::string path = target.substr(5);
+        sockaddr_un addr = {};
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) return nullptr;
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return nullptr;
+        if (connect(fd, (const sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return nullptr; }
+        std::FILE* f = fdopen(fd, "wb");
+        if (!f) close(fd);
+        return f;
+    }
+#else
+    //! The stream is binary: no newline translation on stdout
+    if (target == "-") _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    if (target == "-") return stdout;
+    return std::fopen(target.c_str(), "wb");
+}
+
+std::FILE* OpenInput(const std::string& source) {
+#ifndef _WIN32
+    if (source.compare(0, 5, "unix:") == 0) {
+        std::string path = source.substr(5);
+        sockaddr_un addr = {};
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) return nullptr;
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) return nullptr;
+        unlink(path.c_str());   //! Stale socket of an earlier viewer
+        int fd = -1;
+        if (bind(listener, (const sockaddr*)&addr, sizeof(addr)) == 0 && listen(listener, 1) == 0) fd = accept(listener, nullptr, nullptr);
+        close(listener);
+        unlink(path.c_str());
+        if (fd < 0) return nullptr;
+
+        std::FILE* f = fdopen(fd, "rb");
+        if (!f) close(fd);
+        return f;
+    }
+#else
+    if (source == "-") _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    if (source == "-") return stdin;
+    return std::fopen(source.c_str(), "rb");
+}
+
+void Close(std::FILE* f) {
+    if (!f) return;
+    if (f == stdout || f == stdin) std::fflush(f);
+    else std::fclose(f);
+}
+
+std::uint64_t Hash(const GridView& grid) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto feed = [&h](std::uint8_t b) { h ^= b; h *= 1099511628211ull; };
+
+    for (int y = 0; y < grid.height; y++) {
+        grid.layout.ForEachRun(0, y, grid.width, [&](int i, int, int length) {
+            for (int k = 0; k < length; k++) feed(grid.cells[i + k]);
+        });
+    }
+    for (int y = 0; y < grid.height; y++) {
+        grid.layout.ForEachRun(0, y, grid.width, [&](int i, int, int length) {
+            for (int k = 0; k < length; k++) {
+                std::uint16_t q = QuantizeTemp(grid.temps[i + k]);
+                feed((std::uint8_t)q);
+                feed((std::uint8_t)(q >> 8));
+            }
+        });
+    }
+    return h;
+}
+
+}
+
+//! --- ENCODER ---
+
+bool FrameEncoder::EncodeTile(const GridView& grid, int tx, int ty) {
+    TileIndexes(layout, tx, ty, indexes);
+    const int n = (int)indexes.size();
+    tileData.clear();
+    bool changed = false;
+
+    //! IDs: (zero run, literal count, XOR bytes)
+    for (int i = 0; i < n;) {
+        int start = i;
+        while (i < n && grid.cells[indexes[i]] == cells[indexes[i]]) i++;
+        int zeros = i - start;
+        start = i;
+        while (i < n && grid.cells[indexes[i]] != cells[indexes[i]]) i++;
+
+        PutVarint(tileData, (std::uint32_t)zeros);
+        PutVarint(tileData, (std::uint32_t)(i - start));
+        for (int k = start; k < i; k++) {
+            int index = indexes[k];
+            tileData.push_back((std::uint8_t)(grid.cells[index] ^ cells[index]));
+            cells[index] = grid.cells[index];
+        }
+        changed |= i > start;
+    }
+
+    //! Temperatures: (unchanged run, literal count, zigzag code deltas)
+    for (int i = 0; i < n;) {
+        int start = i;
+        while (i < n && QuantizeTemp(grid.temps[indexes[i]]) == codes[indexes[i]]) i++;
+        int same = i - start;
+        start = i;
+        while (i < n && QuantizeTemp(grid.temps[indexes[i]]) != codes[indexes[i]]) i++;
+
+        PutVarint(tileData, (std::uint32_t)same);
+        PutVarint(tileData, (std::uint32_t)(i - start));
+        for (int k = start; k < i; k++) {
+            int index = indexes[k];
+            std::uint16_t q = QuantizeTemp(grid.temps[index]);
+            PutVarint(tileData, ZigZag((std::int32_t)q - (std::int32_t)codes[index]));
+            codes[index] = q;
+        }
+        changed |= i > start;
+    }
+    return changed;
+}
+
+bool FrameEncoder::Write(std::FILE* out, const GridView& grid) {
+    bool first = stats.frames == 0;
+    if (first) {
+        layout = GridLayout(grid.width, grid.height);
+        tilesX = (grid.width + FrameStream::TILE_SIZE - 1) >> FrameStream::TILE_SHIFT;
+        tilesY = (grid.height + FrameStream::TILE_SIZE - 1) >> FrameStream::TILE_SHIFT;
+
+        StreamHeader header = { FrameStream::MAGIC, FrameStream::VERSION, (std::uint32_t)grid.width, (std::uint32_t)grid.height, (std::uint32_t)FrameStream::TILE_SHIFT, 0 };
+        if (std::fwrite(&header, sizeof(header), 1, out) != 1) return false;
+        stats.bytes += sizeof(header);
+    }
+    else if (grid.width != layout.width || grid.height != layout.height) return false;
+
+    bool key = first || (keyInterval > 0 && stats.frames % keyInterval == 0);
+    if (key) {
+        cells.assign(layout.GetCellCount(), 0);
+        codes.assign(layout.GetCellCount(), 0);
+    }
+
+    //! Tiles first (their count goes in front of them)
+    body.clear();
+    int tileCount = 0, lastTile = -1;
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            int tile = ty * tilesX + tx;
+            if (!key && grid.chunkEpochs && grid.chunkEpochs[tile] <= sentEpoch) continue;
+            if (!EncodeTile(grid, tx, ty)) continue;
+
+            PutVarint(body, (std::uint32_t)(tile - lastTile - 1));
+            body.insert(body.end(), tileData.begin(), tileData.end());
+            lastTile = tile;
+            tileCount++;
+        }
+    }
+    sentEpoch = grid.changeEpoch;
+
+    std::vector<std::uint8_t> head;
+    head.push_back(key ? FLAG_KEY : 0);
+    PutVarint(head, grid.tick);
+    PutVarint(head, ZigZag(grid.originX));
+    PutVarint(head, ZigZag(grid.originY));
+    PutVarint(head, (std::uint32_t)tileCount);
+
+    std::uint32_t size = (std::uint32_t)(head.size() + body.size());
+    bool ok = std::fwrite(&size, sizeof(size), 1, out) == 1
+        && std::fwrite(head.data(), 1, head.size(), out) == head.size()
+        && std::fwrite(body.data(), 1, body.size(), out) == body.size()
+        && std::fflush(out) == 0;
+
+    stats.frames++;
+    stats.keyFrames += key;
+    stats.tiles += tileCount;
+    stats.bytes += sizeof(size) + size;
+    return ok;
+}
+
+//! --- DECODER ---
+
+bool FrameDecoder::Open(std::FILE* f) {
+    StreamHeader header;
+    if (!f || std::fread(&header, sizeof(header), 1, f) != 1) return false;
+    if (header.magic != FrameStream::MAGIC || header.version != FrameStream::VERSION) return false;
+    if (header.tileShift != (std::uint32_t)FrameStream::TILE_SHIFT) return false;
+    if (header.width == 0 || header.height == 0 || header.width > 65536 || header.height > 65536) return false;
+
+    in = f;
+    ended = false;
+    layout = GridLayout((int)header.width, (int)header.height);
+    tilesX = (layout.width + FrameStream::TILE_SIZE - 1) >> FrameStream::TILE_SHIFT;
+    tilesY = (layout.height + FrameStream::TILE_SIZE - 1) >> FrameStream::TILE_SHIFT;
+
+    cells.assign(layout.GetCellCount(), 0);
+    codes.assign(layout.GetCellCount(), 0);
+    temps.assign(layout.GetCellCount(), DequantizeTemp(0));
+    chunkEpochs.assign((std::size_t)tilesX * tilesY, 0);
+    changeEpoch = 0;
+    return true;
+}
+
+bool FrameDecoder::DecodeTile(const std::uint8_t*& p, const std::uint8_t* end, int tile) {
+    TileIndexes(layout, tile % tilesX, tile / tilesX, indexes);
+    const std::uint32_t n = (std::uint32_t)indexes.size();
+
+    for (std::uint32_t i = 0; i < n;) {
+        std::uint32_t zeros, count;
+        if (!GetVarint(p, end, zeros) || !GetVarint(p, end, count)) return false;
+        if (zeros > n - i || count > n - i - zeros || end - p < (std::ptrdiff_t)count) return false;
+        i += zeros;
+        for (std::uint32_t k = 0; k < count; k++) {
+            CellType id = (CellType)(cells[indexes[i + k]] ^ p[k]);
+            if (!IsSimElement(id)) return false;
+            cells[indexes[i + k]] = id;
+        }
+        p += count;
+        i += count;
+    }
+
+    for (std::uint32_t i = 0; i < n;) {
+        std::uint32_t same, count;
+        if (!GetVarint(p, end, same) || !GetVarint(p, end, count)) return false;
+        if (same > n - i || count > n - i - same) return false;
+        i += same;
+        for (std::uint32_t k = 0; k < count; k++, i++) {
+            std::uint32_t delta;
+            if (!GetVarint(p, end, delta)) return false;
+            std::int32_t q = (std::int32_t)codes[indexes[i]] + UnZigZag(delta);
+            if (q < 0 || q > 0xFFFF) return false;
+            codes[indexes[i]] = (std::uint16_t)q;
+            temps[indexes[i]] = DequantizeTemp((std::uint16_t)q);
+        }
+    }
+    return true;
+}
+
+bool FrameDecoder::Next() {
+    std::uint32_t size;
+    if (!in) return false;
+    std::size_t got = std::fread(&size, 1, sizeof(size), in);
+    ended = got == 0 && std::feof(in);
+    if (got != sizeof(size)) return false;
+
+    //! Generous bound (every cell changed, worst-case varints) so a corrupt size cannot allocate wildly
+    if ((std::uint64_t)size > 64 + (std::uint64_t)layout.width * layout.height * 6 + (std::uint64_t)tilesX * tilesY * 24) return false;
+    body.resize(size);
+    if (size > 0 && std::fread(body.data(), 1, size, in) != size) return false;
+
+    const std::uint8_t* p = body.data();
+    const std::uint8_t* end = p + size;
+    std::uint32_t tickValue, ox, oy, count;
+    if (p >= end) return false;
+    std::uint8_t flags = *p++;
+    if (!GetVarint(p, end, tickValue) || !GetVarint(p, end, ox) || !GetVarint(p, end, oy) || !GetVarint(p, end, count)) return false;
+    if (count > (std::uint32_t)(tilesX * tilesY)) return false;
+
+    keyFrame = (flags & FLAG_KEY) != 0;
+    tick = tickValue;
+    originX = UnZigZag(ox);
+    originY = UnZigZag(oy);
+    frameTiles = (int)count;
+    frameBytes = size;
+    changeEpoch++;
+
+    if (keyFrame) {
+        std::fill(cells.begin(), cells.end(), (CellType)0);
+        std::fill(codes.begin(), codes.end(), (std::uint16_t)0);
+        std::fill(temps.begin(), temps.end(), DequantizeTemp(0));
+        std::fill(chunkEpochs.begin(), chunkEpochs.end(), changeEpoch);
+    }
+
+    int tile = -1;
+    for (std::uint32_t t = 0; t < count; t++) {
+        std::uint32_t skip;
+        if (!GetVarint(p, end, skip) || skip >= (std::uint32_t)(tilesX * tilesY - tile - 1)) return false;
+        tile += (int)skip + 1;
+        if (!DecodeTile(p, end, tile)) return false;
+        chunkEpochs[tile] = changeEpoch;
+    }
+    return p == end;
+}
+
+GridView FrameDecoder::GetView() const {
+    GridView v;
+    v.cells = cells.data();
+    v.temps = temps.data();
+    v.width = layout.width;
+    v.height = layout.height;
+    v.layout = layout;
+    v.chunkEpochs = chunkEpochs.data();
+    v.chunksX = tilesX;
+    v.changeEpoch = changeEpoch;
+    v.tick = tick;
+    v.originX = originX;
+    v.originY = originY;
+    return v;
+}
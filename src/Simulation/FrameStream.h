@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "GridView.h"
+
+//! Delta-compressed stream of simulation frames, for headless runs watched or recorded elsewhere.
+//!
+//! A stream is a 24-byte header (magic, version, width, height, tile shift, reserved) followed
+//! by frames. Each frame is a little-endian uint32 byte count and a body: flags (bit 0 = key
+//! frame), varint tick, zigzag varint origin x / y, varint tile count, then the tiles that differ
+//! from the previous frame. Tiles are the World's chunks (TILE_SIZE square, clipped at the grid
+//! edge), cells row-major within a tile:
+//!  - varint tile index, relative to the previous tile of the frame + 1;
+//!  - element IDs XORed with the previous frame, as (varint zero run, varint literal count,
+//!    literal bytes) pairs until the tile is covered;
+//!  - temperatures quantized to 16 bits over MIN_TEMP..MAX_TEMP (like Snapshot), as (varint
+//!    unchanged run, varint literal count, zigzag varint code deltas) pairs.
+//! Key frames are deltas against an all-zero grid, so a reader can start from any of them.
+//! Only chunks whose change epoch moved are compared, so idle regions cost nothing to send.
+namespace FrameStream {
+
+    const std::uint32_t MAGIC = 0x4D525344;  //! "DSRM"
+    const std::uint32_t VERSION = 1;
+    const int TILE_SHIFT = 5;
+    const int TILE_SIZE = 1 << TILE_SHIFT;
+
+    //! Output endpoint: a file path, "-" for stdout (pipes) or, on POSIX, "unix:PATH" to connect
+    //! to a viewer listening on a local socket. Broken pipes make writes fail instead of raising
+    //! SIGPIPE. nullptr if it cannot be opened.
+    std::FILE* OpenOutput(const std::string& target);
+
+    //! Input endpoint: a file path, "-" for stdin or, on POSIX, "unix:PATH" to listen on a local
+    //! socket and wait for one writer to connect
+    std::FILE* OpenInput(const std::string& source);
+
+    //! Closes an endpoint from OpenOutput / OpenInput (stdin and stdout are only flushed)
+    void Close(std::FILE* f);
+
+    //! FNV-1a over the row-major element IDs and 16-bit temperature codes of 'grid': equal
+    //! hashes mean a reader reconstructed the frame exactly as it was sent
+    std::uint64_t Hash(const GridView& grid);
+}
+
+//! Writes frames of one grid to a stream; keeps a copy of what it sent to diff against
+class FrameEncoder {
+public:
+    //! 'keyInterval': frames between key frames (0 = the first frame only)
+    explicit FrameEncoder(int keyInterval = 0) : keyInterval(keyInterval) {}
+
+    struct Stats {
+        int frames = 0;
+        int keyFrames = 0;
+        std::uint64_t tiles = 0;    //! Tiles sent
+        std::uint64_t bytes = 0;    //! Stream bytes, header included
+    };
+
+    //! Appends a frame of 'grid' to 'out' (the stream header first, on the first call) and
+    //! flushes it. False on write errors or if the grid size changed.
+    bool Write(std::FILE* out, const GridView& grid);
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    int keyInterval;
+    int tilesX = 0, tilesY = 0;
+    GridLayout layout;
+    std::uint32_t sentEpoch = 0;
+
+    //! Last frame sent (IDs and temperature codes), in 'layout' order
+    std::vector<CellType> cells;
+    std::vector<std::uint16_t> codes;
+
+    //! Scratch of one frame (reused)
+    std::vector<std::uint8_t> body, tileData;
+    std::vector<int> indexes;
+    Stats stats;
+
+    //! Encodes tile (tx, ty) into 'tileData' and updates the copy; false if it did not change
+    bool EncodeTile(const GridView& grid, int tx, int ty);
+};
+
+//! Reconstructs frames from a stream
+class FrameDecoder {
+public:
+    //! Reads the stream header from 'in'; false if it is not a frame stream
+    bool Open(std::FILE* in);
+
+    //! Reads and applies the next frame; false at the end of the stream or on a truncated or
+    //! corrupt frame (tiles before the damage are applied, so resume from the next key frame)
+    bool Next();
+
+    //! True once Next() stopped at a clean end of the stream (between frames)
+    bool IsEnded() const { return ended; }
+
+    //! The reconstructed grid, with chunk epochs of the tiles each frame touched (so renderers
+    //! can redraw only those). Valid until the next call to Next().
+    GridView GetView() const;
+
+    int GetWidth() const { return layout.width; }
+    int GetHeight() const { return layout.height; }
+    std::uint32_t GetTick() const { return tick; }
+    bool IsKeyFrame() const { return keyFrame; }
+    int GetFrameTiles() const { return frameTiles; }       //! Tiles in the last frame
+    std::uint32_t GetFrameBytes() const { return frameBytes; }  //! Body size of the last frame
+
+private:
+    std::FILE* in = nullptr;
+    GridLayout layout;
+    int tilesX = 0, tilesY = 0;
+
+    std::vector<CellType> cells;
+    std::vector<std::uint16_t> codes;
+    std::vector<CellTemp> temps;
+    std::vector<std::uint32_t> chunkEpochs;
+    std::uint32_t changeEpoch = 0;
+
+    std::uint32_t tick = 0;
+    int originX = 0, originY = 0;
+    bool keyFrame = false;
+    bool ended = false;
+    int frameTiles = 0;
+    std::uint32_t frameBytes = 0;
+    std::vector<std::uint8_t> body;
+    std::vector<int> indexes;
+
+    //! Applies one tile from [p, end); false if it is malformed
+    bool DecodeTile(const std::uint8_t*& p, const std::uint8_t* end, int tile);
+};
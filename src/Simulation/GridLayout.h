@@ -0,0 +1,104 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+//! Maps cell coordinates to positions in the per-cell arrays (element IDs, temperatures, flags).
+//!
+//! Row-major by default: index = y * width + x, so a vertical neighbor is a whole row away
+//! and, on wide worlds, on another cache line or page. DINO_TILED_GRID stores the grid as
+//! TILE_SIZE x TILE_SIZE tiles instead (tiles row-major, cells row-major within a tile): the
+//! 3x3 neighborhood of a cell spans a few hundred bytes, and each tile is one contiguous block.
+//! Tiled storage is padded to whole tiles; padding cells stay EMPTY at their initial temperature.
+//!
+//! Either way, cells along a row are contiguous up to the next tile edge (RunLength), so row
+//! loops stay vectorizable. Code that walks the arrays goes through Index() or ForEachRun()
+//! and never assumes y * width + x; files and hashes use row-major order (ToRowMajor).
+struct GridLayout {
+    static const int TILE_SHIFT = 5;
+    static const int TILE_SIZE = 1 << TILE_SHIFT;
+    static const int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+#ifdef DINO_TILED_GRID
+    static constexpr bool TILED = true;
+#else
+    static constexpr bool TILED = false;
+#endif
+
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+
+    GridLayout() = default;
+    GridLayout(int w, int h) : width(w), height(h), tilesX((w + TILE_SIZE - 1) >> TILE_SHIFT) {}
+
+    //! Size of the per-cell arrays
+    std::size_t GetCellCount() const {
+        if constexpr (TILED) return (std::size_t)tilesX * ((height + TILE_SIZE - 1) >> TILE_SHIFT) * TILE_CELLS;
+        else return (std::size_t)width * height;
+    }
+
+    //! Array index of cell (x, y). Coordinates one cell outside the grid map to some index
+    //! without faulting, so neighbor indices may be formed before their bounds are checked.
+    int Index(int x, int y) const {
+        if constexpr (TILED) {
+            return ((y >> TILE_SHIFT) * tilesX + (x >> TILE_SHIFT)) * TILE_CELLS + (y & (TILE_SIZE - 1)) * TILE_SIZE + (x & (TILE_SIZE - 1));
+        }
+        else return y * width + x;
+    }
+
+    //! Index(x + dx, y + dy) from the index of (x, y), for |dx|, |dy| <= 1: a fixed offset
+    //! unless the step leaves the tile
+    int Neighbor(int index, int x, int y, int dx, int dy) const {
+        if constexpr (TILED) {
+            int lx = (x & (TILE_SIZE - 1)) + dx, ly = (y & (TILE_SIZE - 1)) + dy;
+            if ((unsigned int)lx < TILE_SIZE && (unsigned int)ly < TILE_SIZE) return index + dy * TILE_SIZE + dx;
+            return Index(x + dx, y + dy);
+        }
+        else return index + dy * width + dx;
+    }
+
+    //! Inverse of Index()
+    int X(int index) const {
+        if constexpr (TILED) return ((index / TILE_CELLS) % tilesX) * TILE_SIZE + (index & (TILE_SIZE - 1));
+        else return index % width;
+    }
+    int Y(int index) const {
+        if constexpr (TILED) return ((index / TILE_CELLS) / tilesX) * TILE_SIZE + ((index / TILE_SIZE) & (TILE_SIZE - 1));
+        else return index / width;
+    }
+
+    //! Cells from x rightwards that are contiguous in storage
+    int RunLength(int x) const {
+        if constexpr (TILED) return TILE_SIZE - (x & (TILE_SIZE - 1));
+        else return width - x;
+    }
+
+    //! Calls fn(index, offset, length) for each contiguous piece of the row span
+    //! [x0, x0 + count) of row y; 'offset' is the piece's distance from x0
+    template <typename Fn>
+    void ForEachRun(int x0, int y, int count, Fn fn) const {
+        for (int offset = 0; offset < count;) {
+            int x = x0 + offset;
+            int length = std::min(count - offset, RunLength(x));
+            fn(Index(x, y), offset, length);
+            offset += length;
+        }
+    }
+
+    //! Whole-grid conversions to and from row-major order (width * height elements)
+    template <typename T>
+    void ToRowMajor(const T* src, T* dst) const {
+        for (int y = 0; y < height; y++) {
+            T* row = dst + (std::size_t)y * width;
+            ForEachRun(0, y, width, [&](int index, int offset, int length) { std::copy_n(src + index, length, row + offset); });
+        }
+    }
+
+    template <typename T>
+    void FromRowMajor(const T* src, T* dst) const {
+        for (int y = 0; y < height; y++) {
+            const T* row = src + (std::size_t)y * width;
+            ForEachRun(0, y, width, [&](int index, int offset, int length) { std::copy_n(row + offset, length, dst + index); });
+        }
+    }
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include "CellFormat.h"
+#include "GridLayout.h"
+
+//! Read-only window onto grid state: the live World (World::GetView) or a frame published
+//! by SimulationRunner. Renderers read this instead of a World, so they never need to know
+//! whether the grid behind it is being updated on another thread.
+struct GridView {
+    const CellType* cells = nullptr;
+    const CellTemp* temps = nullptr;   //! Decode with DecodeTemp
+    int width = 0;
+    int height = 0;
+
+    //! Where each cell lives in 'cells' and 'temps'
+    GridLayout layout;
+
+    //! Change epoch of every chunk (see World::GetChunkEpochs) and of the state as a whole
+    const std::uint32_t* chunkEpochs = nullptr;
+    int chunksX = 0;
+    std::uint32_t changeEpoch = 0;
+
+    //! World::GetTick() of the state
+    std::uint32_t tick = 0;
+
+    //! Position of cell (0, 0) in a streamed world (see WorldPager); 0 otherwise
+    int originX = 0;
+    int originY = 0;
+
+    int Index(int x, int y) const { return layout.Index(x, y); }
+    bool IsValid(int index) const { return index >= 0 && (std::size_t)index < layout.GetCellCount(); }
+
+    //! Unchecked accessors by array index (see Index, IsValid)
+    int GetCell(int index) const { return cells[index]; }
+    float GetTemp(int index) const { return DecodeTemp(temps[index]); }
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+//! Simulation-side random numbers.
+//! Replaces raylib's GetRandomValue so World can run without a window.
+//!
+//! Every thread owns an xoshiro128** generator. World re-keys it from (seed, tick, phase, unit)
+//! before each unit of work (a chunk row, a chunk), so the numbers a cell sees depend only on
+//! the world seed and where/when it is updated: the same seed replays bit for bit, whichever
+//! worker thread happens to pick up a chunk.
+namespace Random {
+
+    //! Scrambles a seed (murmur3 finalizer)
+    inline std::uint32_t Mix(std::uint32_t x) {
+        x ^= x >> 16; x *= 0x85EBCA6Bu;
+        x ^= x >> 13; x *= 0xC2B2AE35u;
+        x ^= x >> 16;
+        return x;
+    }
+
+    //! Stateless counter-based hash: the same inputs always give the same 32 bits
+    inline std::uint32_t Hash(std::uint32_t a, std::uint32_t b, std::uint32_t c = 0, std::uint32_t d = 0) {
+        std::uint32_t h = Mix(a + 0x9E3779B9u);
+        h = Mix(h ^ (b + 0x7F4A7C15u));
+        h = Mix(h ^ (c + 0x94D049BBu));
+        return Mix(h ^ (d + 0x2545F491u));
+    }
+
+    //! xoshiro128** (Blackman & Vigna): 128-bit state, a handful of ALU ops per number
+    struct Generator {
+        std::uint32_t s[4];
+
+        static std::uint32_t Rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+        //! Expands a 32-bit key into a full state (splitmix32); never all-zero
+        void SetKey(std::uint32_t key) {
+            for (int k = 0; k < 4; k++) {
+                key += 0x9E3779B9u;
+                s[k] = Mix(key);
+            }
+            if ((s[0] | s[1] | s[2] | s[3]) == 0) s[0] = 1;
+        }
+
+        std::uint32_t Next() {
+            std::uint32_t result = Rotl(s[1] * 5, 7) * 9;
+            std::uint32_t t = s[1] << 9;
+            s[2] ^= s[0]; s[3] ^= s[1];
+            s[1] ^= s[2]; s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = Rotl(s[3], 11);
+            return result;
+        }
+    };
+
+    //! Hands out a distinct default key to each thread that never gets re-keyed
+    inline std::atomic<std::uint32_t>& StreamCounter() {
+        static std::atomic<std::uint32_t> counter{ 0x9E3779B9u };
+        return counter;
+    }
+
+    //! Generator of the calling thread
+    inline Generator& State() {
+        thread_local Generator gen = [] {
+            Generator g;
+            g.SetKey(StreamCounter().fetch_add(0x9E3779B9u));
+            return g;
+        }();
+        return gen;
+    }
+
+    //! Seeds the calling thread (scene setup, tools); threads created afterwards derive their keys from it
+    inline void Seed(std::uint32_t seed) {
+        StreamCounter().store(seed * 0x9E3779B9u + 1u);
+        State().SetKey(Mix(seed));
+    }
+
+    //! Re-keys the calling thread for one unit of simulation work
+    inline void SetStream(std::uint32_t seed, std::uint32_t tick, std::uint32_t phase, std::uint32_t unit) {
+        State().SetKey(Hash(seed, tick, phase, unit));
+    }
+
+    inline std::uint32_t Next() { return State().Next(); }
+
+    //! Returns a random integer in [min, max] (inclusive)
+    inline int Range(int min, int max) {
+        if (min > max) { int t = max; max = min; min = t; }
+        std::uint32_t span = (std::uint32_t)(max - min) + 1u;
+        return (int)(((std::uint64_t)Next() * span) >> 32) + min;
+    }
+
+    //! Bernoulli helper for the "Range(0, n - 1) == 0" pattern: true with probability 1/n
+    inline bool OneIn(std::uint32_t n) {
+        return n <= 1 || Next() < 0xFFFFFFFFu / n;
+    }
+
+    //! Fair coin
+    inline bool Bool() { return (Next() >> 31) != 0; }
+}
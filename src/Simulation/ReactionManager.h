@@ -1,7 +1,8 @@
 #pragma once
 #include "World.h"
 #include "Elements.h"
-#include "raylib.h"
+#include "Reactions.h"
+#include "Random.h"
 
 namespace ReactionManager {
 
@@ -12,81 +13,68 @@ namespace ReactionManager {
         if (type == EMPTY || type == WALL) return;
 
         float temp = world.GetTemp(index);
-        const ElementDef& def = GetElementDef(type);
+        const ElementTable& table = elementTable;
 
         //! High Temperature Conversion (Melting / Boiling)
-        if (def.highTempConvert != -1 && temp > def.highTemp) {
+        if (table.highTempConvert[type] != -1 && temp > table.highTemp[type]) {
             //! Add randomness to avoid uniform transitions
-            if (GetRandomValue(0, 10) == 0) {
+            if (Random::OneIn(11)) {
                 float currentTemp = world.GetTemp(index);
 
-                world.SetCell(index, def.highTempConvert);
+                world.SetCell(index, table.highTempConvert[type]);
 
                 world.SetTemp(index, currentTemp);
             }
         }
         //! Low Temperature Conversion (Freezing / Condensation)
-        else if (def.lowTempConvert != -1 && temp < def.lowTemp) {
-            if (GetRandomValue(0, 50) == 0) {
-                world.SetCell(index, def.lowTempConvert);
+        else if (table.lowTempConvert[type] != -1 && temp < table.lowTemp[type]) {
+            if (Random::OneIn(51)) {
+                world.SetCell(index, table.lowTempConvert[type]);
             }
         }
 
         //! Flammability Check (Spontaneous Combustion)
-        if (def.flammability > 0 && temp > 300.0f) {
-            if (GetRandomValue(0, (int)(1000 * (1.0f - def.flammability))) == 0) {
+        float flammability = table.flammability[type];
+        if (flammability > 0 && temp > 300.0f) {
+            if (Random::OneIn((int)(1000 * (1.0f - flammability)) + 1)) {
                 world.SetCell(index, FIRE);
-                world.SetTemp(index, 800.0f + GetRandomValue(0, 200));
+                world.SetTemp(index, 800.0f + Random::Range(0, 200));
             }
         }
     }
 
+    //! True while a cell sits past a phase-change or ignition threshold.
+    //! The conversion is random, so the cell must stay awake until it happens.
+    inline bool IsUnstable(int type, float temp) {
+        if (type == EMPTY || type == WALL) return false;
+
+        const ElementTable& table = elementTable;
+        if (table.highTempConvert[type] != -1 && temp > table.highTemp[type]) return true;
+        if (table.lowTempConvert[type] != -1 && temp < table.lowTemp[type]) return true;
+        return table.flammability[type] > 0 && temp > 300.0f;
+    }
+
+    //! True if Interact() has a rule for this pair (ignoring the random roll)
+    inline bool CanInteract(int selfType, int neighborType) {
+        return reactionTable.rule[selfType][neighborType].active;
+    }
+
     //! --- CHEMICAL INTERACTIONS ---
-    //! Checks reactions between a cell and its neighbor
+    //! Applies the (self, neighbor) rule from the reaction table, if any.
+    //! Returns true if the reaction happened this tick.
     inline bool Interact(World& world, int selfIndex, int neighborIndex) {
         if (!world.IsValid(neighborIndex)) return false;
 
-        int selfType = world.GetCell(selfIndex);
-        int neighborType = world.GetCell(neighborIndex);
+        const ReactionRule& rule = reactionTable.rule[world.GetCell(selfIndex)][world.GetCell(neighborIndex)];
+        if (!rule.active || !Random::OneIn(rule.chance)) return false;
 
-        if (neighborType == EMPTY || neighborType == WALL) return false;
+        if (rule.neighborProduct != -1) world.SetCell(neighborIndex, rule.neighborProduct);
+        if (rule.selfProduct != -1) world.SetCell(selfIndex, rule.selfProduct);
 
-        //! ACID REACTIONS
-        if (selfType == ACID || selfType == ACIDIC_WATER) {
-            //! Acid contaminates Water
-            if (neighborType == WATER) {
-                world.SetCell(neighborIndex, ACIDIC_WATER);
-                return true;
-            }
-            //! Acid dissolves solids
-            if (selfType == ACID && (neighborType == SAND || neighborType == WOOD || neighborType == STONE)) {
-                if (GetRandomValue(0, 20) == 0) {
-                    world.SetCell(neighborIndex, SMOKE); //! Dissolve into smoke
-                    world.SetCell(selfIndex, EMPTY);     //! Consume acid
-                    return true;
-                }
-            }
+        if (rule.heat != 0.0f) {
+            world.SetTemp(neighborIndex, world.GetTemp(neighborIndex) + rule.heat);
+            world.SetTemp(selfIndex, world.GetTemp(selfIndex) + rule.heat);
         }
-
-        
-        //! STEAM CONDENSATION (Steam + Water/Ice = Water)
-        if (selfType == STEAM && (neighborType == WATER || neighborType == ICE)) {
-            if (GetRandomValue(0, 100) == 0) {
-                world.SetCell(selfIndex, WATER);
-                return true;
-            }
-        }
-        
-
-        
-        //! LAVA COOLING (Lava + Water = Stone + Steam)
-        if (selfType == LAVA && neighborType == WATER) {
-            world.SetCell(selfIndex, STONE);     //! Lava becomes stone
-            world.SetCell(neighborIndex, STEAM); //! Water evaporates
-            return true;
-        }
-        
-
-        return false;
+        return true;
     }
 }
\ No newline at end of file
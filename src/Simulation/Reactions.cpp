@@ -0,0 +1,47 @@
+#include "Reactions.h"
+
+//! ==========================================
+//!             REACTION DATABASE
+//! ==========================================
+//! Format: { SELF, NEIGHBOR, SELF_PRODUCT, NEIGHBOR_PRODUCT, ONE_IN, HEAT }
+std::vector<ReactionDef> reactions = {
+    //! Acid contaminates Water
+    { ACID, WATER, -1, ACIDIC_WATER, 1, 0.0f },
+    { ACIDIC_WATER, WATER, -1, ACIDIC_WATER, 1, 0.0f },
+
+    //! Acid dissolves solids into smoke and is consumed
+    { ACID, SAND, EMPTY, SMOKE, 21, 0.0f },
+    { ACID, WOOD, EMPTY, SMOKE, 21, 0.0f },
+    { ACID, STONE, EMPTY, SMOKE, 21, 0.0f },
+
+    //! Steam condensation (Steam + Water/Ice = Water)
+    { STEAM, WATER, WATER, -1, 101, 0.0f },
+    { STEAM, ICE, WATER, -1, 101, 0.0f },
+
+    //! Lava cooling (Lava + Water = Stone + Steam)
+    { LAVA, WATER, STONE, STEAM, 1, 0.0f }
+};
+
+//! Builds the dense table from the registry (rules naming tools are skipped)
+static ReactionTable BuildReactionTable() {
+    ReactionTable table = {};
+
+    for (const ReactionDef& r : reactions) {
+        if (!IsSimElement(r.self) || !IsSimElement(r.neighbor)) continue;
+        if (r.selfProduct != -1 && !IsSimElement(r.selfProduct)) continue;
+        if (r.neighborProduct != -1 && !IsSimElement(r.neighborProduct)) continue;
+
+        ReactionRule& rule = table.rule[r.self][r.neighbor];
+        rule.active = true;
+        rule.selfProduct = r.selfProduct;
+        rule.neighborProduct = r.neighborProduct;
+        rule.chance = r.chance;
+        rule.heat = r.heat;
+
+        table.reactsWith[r.self] |= 1u << r.neighbor;
+    }
+    return table;
+}
+
+//! Must be defined after 'reactions' (same translation unit, initialized in order)
+const ReactionTable reactionTable = BuildReactionTable();
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Elements.h"
+
+//! One chemical reaction between a cell ('self') and a touching neighbor
+struct ReactionDef {
+    int self;               //! Element that runs the reaction
+    int neighbor;           //! Element it reacts with
+    int selfProduct;        //! What 'self' turns into (-1 = unchanged)
+    int neighborProduct;    //! What the neighbor turns into (-1 = unchanged)
+    std::uint32_t chance;   //! Happens 1 in 'chance' ticks while touching (1 = always)
+    float heat;             //! Added to both products' temperature (0 = products start at their base temperature)
+};
+
+//! Compiled rule for one (self, neighbor) pair
+struct ReactionRule {
+    bool active;            //! False if the pair does not react
+    int selfProduct;
+    int neighborProduct;
+    std::uint32_t chance;
+    float heat;
+};
+
+//! Dense (self, neighbor) lookup: one load per pair, whatever the number of rules
+struct ReactionTable {
+    ReactionRule rule[ELEMENT_COUNT][ELEMENT_COUNT];
+
+    //! Bit n is set if the element reacts with element n; 0 = inert, neighbor checks can be skipped
+    std::uint32_t reactsWith[ELEMENT_COUNT];
+};
+
+static_assert(ELEMENT_COUNT <= 32, "ReactionTable::reactsWith holds one bit per element");
+
+//! Global access to the reaction registry
+extern std::vector<ReactionDef> reactions;
+
+//! Compiled from 'reactions' at startup
+extern const ReactionTable reactionTable;
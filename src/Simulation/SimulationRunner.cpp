@@ -0,0 +1,154 @@
+#include "SimulationRunner.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+SimulationRunner::SimulationRunner(World& world) : world(world) {
+    live.grid = world.GetView();
+}
+
+SimulationRunner::~SimulationRunner() {
+    Stop();
+}
+
+void SimulationRunner::Start(double tickRate) {
+    if (IsThreaded()) return;
+
+    //! Every buffer starts as a full copy, later publishes only copy changed chunks
+    for (Buffer& b : buffers) {
+        b.cells = world.GetGridData();
+        b.temps = world.GetTempData();
+        b.chunkEpochs = world.GetChunkEpochs();
+        b.epoch = world.GetChangeEpoch();
+        b.frame = live;
+        b.frame.grid = world.GetView();
+        b.frame.grid.cells = b.cells.data();
+        b.frame.grid.temps = b.temps.data();
+        b.frame.grid.chunkEpochs = b.chunkEpochs.data();
+    }
+    back = 0;
+    front = 1;
+    middle.store(2, std::memory_order_relaxed);
+
+    stopping = false;
+    thread = std::thread(&SimulationRunner::Run, this, tickRate);
+}
+
+void SimulationRunner::Stop() {
+    if (!IsThreaded()) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepSignal.notify_all();
+    thread.join();
+}
+
+void SimulationRunner::Submit(Command command) {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    commands.push_back(std::move(command));
+}
+
+void SimulationRunner::ApplyCommands() {
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        running.swap(commands);
+    }
+    for (Command& command : running) command(world);
+    running.clear();
+}
+
+void SimulationRunner::Tick() {
+    ApplyCommands();
+
+    double updateMs = 0.0;
+    {
+        ScopedTimer timer(updateMs);
+        world.Update();
+    }
+    live.updateMs = updateMs;
+    live.timings = world.GetLastTimings();
+    live.counters = world.GetLastCounters();
+    ticksRun.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SimulationRunner::Step() {
+    Tick();
+}
+
+const SimFrame& SimulationRunner::AcquireFrame() {
+    if (!IsThreaded()) {
+        live.grid = world.GetView();
+        return live;
+    }
+
+    //! Take the newest frame, hand the one drawn before back to the writer
+    if (middle.load(std::memory_order_relaxed) & FRESH) front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+    return buffers[front].frame;
+}
+
+void SimulationRunner::Publish() {
+    Buffer& b = buffers[back];
+    GridView src = world.GetView();
+
+    //! Copy runs of chunks changed since this buffer was last filled, row by row
+    for (int cy = 0; cy * World::CHUNK_SIZE < src.height; cy++) {
+        int y0 = cy * World::CHUNK_SIZE;
+        int y1 = std::min(y0 + World::CHUNK_SIZE, src.height);
+
+        for (int cx = 0; cx < src.chunksX; cx++) {
+            if (src.chunkEpochs[cy * src.chunksX + cx] <= b.epoch) continue;
+
+            int first = cx;
+            while (cx + 1 < src.chunksX && src.chunkEpochs[cy * src.chunksX + cx + 1] > b.epoch) cx++;
+
+            int x0 = first * World::CHUNK_SIZE;
+            int count = std::min((cx + 1) * World::CHUNK_SIZE, src.width) - x0;
+            for (int y = y0; y < y1; y++) {
+                src.layout.ForEachRun(x0, y, count, [&](int i, int, int length) {
+                    std::copy_n(src.cells + i, length, &b.cells[i]);
+                    std::copy_n(src.temps + i, length, &b.temps[i]);
+                });
+            }
+        }
+    }
+    std::copy_n(src.chunkEpochs, b.chunkEpochs.size(), b.chunkEpochs.data());
+    b.epoch = src.changeEpoch;
+
+    b.frame.updateMs = live.updateMs;
+    b.frame.timings = live.timings;
+    b.frame.counters = live.counters;
+    b.frame.grid.changeEpoch = src.changeEpoch;
+    b.frame.grid.tick = src.tick;
+    b.frame.grid.originX = src.originX;
+    b.frame.grid.originY = src.originY;
+
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+void SimulationRunner::Run(double tickRate) {
+    using Clock = std::chrono::steady_clock;
+
+    //! tickRate <= 0: as fast as possible
+    Clock::duration period = tickRate > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickRate))
+        : Clock::duration::zero();
+    Clock::time_point next = Clock::now();
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        int ticks = 0;
+        while (ticks < MAX_CATCH_UP && Clock::now() >= next) {
+            Tick();
+            next += period;
+            ticks++;
+        }
+
+        //! Still late: slow down the simulation instead of piling up ticks it cannot catch up with
+        if (ticks == MAX_CATCH_UP && Clock::now() > next) next = Clock::now();
+
+        if (ticks > 0) Publish();
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepSignal.wait_until(lock, next, [this] { return stopping.load(std::memory_order_relaxed); });
+    }
+}
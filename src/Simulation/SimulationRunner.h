@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "World.h"
+#include "GridView.h"
+
+//! One simulation state as the renderer sees it: the grid plus the statistics of the tick that produced it
+struct SimFrame {
+    GridView grid;
+    double updateMs = 0.0;      //! Wall-clock cost of the World::Update() that produced it
+    TickTimings timings;
+    TickCounters counters;
+};
+
+//! Drives a World either in lockstep with the caller (Step) or on its own thread at a fixed tick rate (Start).
+//!
+//! Edits are queued as commands and applied on the simulation thread between ticks, so the
+//! grid is never written while it is updated. After each batch of ticks the thread publishes
+//! a copy of the grid through a triple buffer: the reader always gets the newest complete
+//! frame without locking, and the writer never waits for the reader. Only chunks that changed
+//! since a buffer was last filled are copied into it (see World::GetChunkEpochs).
+class SimulationRunner {
+public:
+    using Command = std::function<void(World&)>;
+
+    //! Ticks run back to back at most before a late simulation drops its backlog
+    static const int MAX_CATCH_UP = 4;
+
+    explicit SimulationRunner(World& world);
+    ~SimulationRunner();
+
+    SimulationRunner(const SimulationRunner&) = delete;
+    SimulationRunner& operator=(const SimulationRunner&) = delete;
+
+    //! Starts the simulation thread at 'tickRate' ticks per second (no-op if already running)
+    void Start(double tickRate);
+
+    //! Stops and joins the thread; the World is the caller's again
+    void Stop();
+
+    bool IsThreaded() const { return thread.joinable(); }
+
+    //! Queues an edit for the next tick boundary (any thread)
+    void Submit(Command command);
+
+    //! Lockstep mode: applies the queued commands and runs one tick on the calling thread
+    void Step();
+
+    //! Newest state. Threaded: the last published frame, valid until the next AcquireFrame();
+    //! lockstep: a view of the live World.
+    const SimFrame& AcquireFrame();
+
+    //! Ticks run by the simulation thread since Start() (including dropped backlogs)
+    std::uint32_t GetTicksRun() const { return ticksRun.load(std::memory_order_relaxed); }
+
+private:
+    //! Storage behind a published frame
+    struct Buffer {
+        std::vector<CellType> cells;
+        std::vector<CellTemp> temps;
+        std::vector<std::uint32_t> chunkEpochs;
+        std::uint32_t epoch = 0;    //! World change epoch the copy is current with
+        SimFrame frame;
+    };
+
+    World& world;
+
+    std::mutex commandMutex;
+    std::vector<Command> commands;
+    std::vector<Command> running;   //! Commands being applied (simulation thread only)
+
+    //! Lockstep frame (views the World directly) and the statistics of the last tick
+    SimFrame live;
+
+    //! Triple buffer: the writer owns 'back', the reader owns 'front', 'middle' is exchanged
+    //! atomically between them. FRESH is set on 'middle' when it holds an unread frame.
+    static const int FRESH = 4;
+    Buffer buffers[3];
+    int back = 0;
+    int front = 1;
+    std::atomic<int> middle{ 2 };
+
+    std::thread thread;
+    std::atomic<bool> stopping{ false };
+
+    //! Cuts the wait for the next tick short when Stop() is called
+    std::mutex sleepMutex;
+    std::condition_variable sleepSignal;
+    std::atomic<std::uint32_t> ticksRun{ 0 };
+
+    void ApplyCommands();
+    void Tick();
+
+    //! Brings 'back' up to date with the World and swaps it into 'middle'
+    void Publish();
+
+    void Run(double tickRate);
+};
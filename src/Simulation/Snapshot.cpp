@@ -0,0 +1,371 @@
+#include "Snapshot.h"
+#include "Core/MappedFile.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Snapshot {
+
+//! On-disk header (written as-is: the format is little-endian, like every supported target)
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t width, height;
+    std::uint32_t seed;
+    std::uint32_t tick;
+    std::uint32_t cellEncoding;
+    std::uint32_t tempEncoding;
+    std::uint32_t tempBytes;
+    std::uint32_t chunkShift;   //! World::CHUNK_SHIFT of the writer (pending rects are per chunk)
+    std::uint64_t cellOffset, cellSize;
+    std::uint64_t tempOffset, tempSize;
+    std::uint64_t chunkOffset, chunkSize;   //! Pending dirty rects (int32, see below); size 0 = wake everything
+    std::uint64_t coarseOffset, coarseSize; //! Pending coarse heat (float per chunk); version 3 on
+};
+static_assert(sizeof(FileHeader) == 104, "FileHeader layout changed");
+
+//! Header size of version 1 and 2 files (no coarse section)
+static const std::size_t HEADER_V2_SIZE = 88;
+
+//! Sections start on this boundary so raw buffers can be copied aligned from the mapping
+static const std::uint64_t SECTION_ALIGN = 64;
+
+//! Fixed-point scale of the 16-bit temperature quantization (same as DINO_COMPACT_TEMP)
+static const float QUANT_SCALE = 65535.0f / (MAX_TEMP - MIN_TEMP);
+
+static std::uint16_t QuantizeTemp(CellTemp t) {
+#ifdef DINO_COMPACT_TEMP
+    return t;
+#else
+    float v = std::min(std::max(t, MIN_TEMP), MAX_TEMP);
+    return (std::uint16_t)((v - MIN_TEMP) * QUANT_SCALE + 0.5f);
+#endif
+}
+
+static CellTemp DequantizeTemp(std::uint16_t q) {
+#ifdef DINO_COMPACT_TEMP
+    return q;
+#else
+    return MIN_TEMP + q * (1.0f / QUANT_SCALE);
+#endif
+}
+
+//! --- VARINTS (LEB128) ---
+static void PutVarint(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((std::uint8_t)v);
+}
+
+//! Bounds-checked reader over a mapped section
+struct Reader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+
+    bool Byte(std::uint8_t& v) {
+        if (p >= end) return false;
+        v = *p++;
+        return true;
+    }
+
+    bool Varint(std::uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (p >= end) return false;
+            std::uint8_t b = *p++;
+            v |= (std::uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+static std::uint32_t ZigZag(std::int32_t v) { return ((std::uint32_t)v << 1) ^ (std::uint32_t)(v >> 31); }
+static std::int32_t UnZigZag(std::uint32_t v) { return (std::int32_t)(v >> 1) ^ -(std::int32_t)(v & 1); }
+
+//! --- ELEMENT IDS: (id, length - 1) runs ---
+static void EncodeCells(const CellType* cells, std::size_t count, std::vector<std::uint8_t>& out) {
+    std::size_t i = 0;
+    while (i < count) {
+        std::size_t run = 1;
+        while (i + run < count && cells[i + run] == cells[i] && run < 0xFFFFFFFFu) run++;
+        out.push_back(cells[i]);
+        PutVarint(out, (std::uint32_t)(run - 1));
+        i += run;
+    }
+}
+
+//! With 'cells' == nullptr only validates (every ID known, exactly 'count' cells)
+static bool DecodeCells(Reader in, CellType* cells, std::size_t count) {
+    std::size_t i = 0;
+    while (i < count) {
+        std::uint8_t id;
+        std::uint32_t run;
+        if (!in.Byte(id) || !in.Varint(run)) return false;
+        if (!IsSimElement(id) || (std::size_t)run >= count - i) return false;
+
+        if (cells) std::fill(cells + i, cells + i + run + 1, (CellType)id);
+        i += (std::size_t)run + 1;
+    }
+    return in.p == in.end;
+}
+
+//! --- TEMPERATURES: (length - 1, zigzag delta) runs over 16-bit codes ---
+static void EncodeTemps(const CellTemp* temps, std::size_t count, std::vector<std::uint8_t>& out) {
+    std::uint16_t prev = 0;
+    std::size_t i = 0;
+    while (i < count) {
+        std::uint16_t q = QuantizeTemp(temps[i]);
+        std::size_t run = 1;
+        while (i + run < count && QuantizeTemp(temps[i + run]) == q && run < 0xFFFFFFFFu) run++;
+
+        PutVarint(out, (std::uint32_t)(run - 1));
+        PutVarint(out, ZigZag((std::int32_t)q - (std::int32_t)prev));
+        prev = q;
+        i += run;
+    }
+}
+
+static bool DecodeTemps(Reader in, CellTemp* temps, std::size_t count) {
+    std::int32_t prev = 0;
+    std::size_t i = 0;
+    while (i < count) {
+        std::uint32_t run, delta;
+        if (!in.Varint(run) || !in.Varint(delta)) return false;
+        if ((std::size_t)run >= count - i) return false;
+
+        std::int32_t q = prev + UnZigZag(delta);
+        if (q < 0 || q > 0xFFFF) return false;
+
+        if (temps) std::fill(temps + i, temps + i + run + 1, DequantizeTemp((std::uint16_t)q));
+        prev = q;
+        i += (std::size_t)run + 1;
+    }
+    return in.p == in.end;
+}
+
+//! Raw temperatures from a build with the other CellTemp format are converted on the way in
+static bool CopyRawTemps(const std::uint8_t* src, std::uint32_t bytesPerTemp, CellTemp* temps, std::size_t count) {
+    if (bytesPerTemp == sizeof(CellTemp)) {
+        std::memcpy(temps, src, count * sizeof(CellTemp));
+        return true;
+    }
+    if (bytesPerTemp == 4) {
+        for (std::size_t i = 0; i < count; i++) {
+            float t;
+            std::memcpy(&t, src + i * 4, 4);
+            temps[i] = EncodeTemp(t);
+        }
+        return true;
+    }
+    if (bytesPerTemp == 2) {
+        for (std::size_t i = 0; i < count; i++) {
+            std::uint16_t q;
+            std::memcpy(&q, src + i * 2, 2);
+            temps[i] = DequantizeTemp(q);
+        }
+        return true;
+    }
+    return false;
+}
+
+static std::uint64_t AlignUp(std::uint64_t v) { return (v + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1); }
+
+bool Save(const World& world, const std::string& path, bool compress) {
+    //! Files are row-major: tiled grids are reordered first
+    std::vector<CellType> grid;
+    std::vector<CellTemp> temps;
+    if constexpr (GridLayout::TILED) {
+        std::size_t count = (std::size_t)world.GetWidth() * world.GetHeight();
+        grid.resize(count);
+        temps.resize(count);
+        world.GetLayout().ToRowMajor(world.GetGridData().data(), grid.data());
+        world.GetLayout().ToRowMajor(world.GetTempData().data(), temps.data());
+    }
+    const std::vector<CellType>& gridRows = GridLayout::TILED ? grid : world.GetGridData();
+    const std::vector<CellTemp>& tempRows = GridLayout::TILED ? temps : world.GetTempData();
+
+    std::vector<std::uint8_t> cellData, tempData;
+    const void* cellBytes = gridRows.data();
+    const void* tempBytes = tempRows.data();
+    std::uint64_t cellSize = gridRows.size() * sizeof(CellType);
+    std::uint64_t tempSize = tempRows.size() * sizeof(CellTemp);
+
+    std::vector<std::int32_t> pending;
+    world.GetPendingRects(pending);
+    std::vector<float> coarsePending;
+    world.GetCoarsePending(coarsePending);
+
+    if (compress) {
+        EncodeCells(gridRows.data(), gridRows.size(), cellData);
+        EncodeTemps(tempRows.data(), tempRows.size(), tempData);
+        cellBytes = cellData.data(); cellSize = cellData.size();
+        tempBytes = tempData.data(); tempSize = tempData.size();
+    }
+
+    FileHeader header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.width = (std::uint32_t)world.GetWidth();
+    header.height = (std::uint32_t)world.GetHeight();
+    header.seed = world.GetSeed();
+    header.tick = world.GetTick();
+    header.cellEncoding = compress ? ENCODING_RLE : ENCODING_RAW;
+    header.tempEncoding = compress ? ENCODING_RLE : ENCODING_RAW;
+    header.tempBytes = compress ? 2u : (std::uint32_t)sizeof(CellTemp);
+    header.chunkShift = World::CHUNK_SHIFT;
+    header.cellOffset = AlignUp(sizeof(FileHeader));
+    header.cellSize = cellSize;
+    header.tempOffset = AlignUp(header.cellOffset + cellSize);
+    header.tempSize = tempSize;
+    header.chunkOffset = AlignUp(header.tempOffset + tempSize);
+    header.chunkSize = pending.size() * sizeof(std::int32_t);
+    header.coarseOffset = AlignUp(header.chunkOffset + header.chunkSize);
+    header.coarseSize = coarsePending.size() * sizeof(float);
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    static const std::uint8_t padding[SECTION_ALIGN] = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(padding, 1, (size_t)(header.cellOffset - sizeof(header)), file) == header.cellOffset - sizeof(header);
+    ok = ok && std::fwrite(cellBytes, 1, (size_t)cellSize, file) == cellSize;
+    ok = ok && std::fwrite(padding, 1, (size_t)(header.tempOffset - header.cellOffset - cellSize), file) == header.tempOffset - header.cellOffset - cellSize;
+    ok = ok && std::fwrite(tempBytes, 1, (size_t)tempSize, file) == tempSize;
+    ok = ok && std::fwrite(padding, 1, (size_t)(header.chunkOffset - header.tempOffset - tempSize), file) == header.chunkOffset - header.tempOffset - tempSize;
+    ok = ok && std::fwrite(pending.data(), 1, (size_t)header.chunkSize, file) == header.chunkSize;
+    ok = ok && std::fwrite(padding, 1, (size_t)(header.coarseOffset - header.chunkOffset - header.chunkSize), file) == header.coarseOffset - header.chunkOffset - header.chunkSize;
+    ok = ok && std::fwrite(coarsePending.data(), 1, (size_t)header.coarseSize, file) == header.coarseSize;
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+//! Checks the header against the mapped file size
+static bool ParseHeader(const MappedFile& file, FileHeader& header) {
+    if (file.GetSize() < HEADER_V2_SIZE) return false;
+    header = {};
+    std::memcpy(&header, file.GetData(), HEADER_V2_SIZE);
+
+    if (header.magic != MAGIC || header.version < 1 || header.version > VERSION) return false;
+    if (header.version >= 3) {
+        if (file.GetSize() < sizeof(FileHeader)) return false;
+        std::memcpy(&header, file.GetData(), sizeof(FileHeader));
+    }
+    if (header.width == 0 || header.height == 0) return false;
+    if (header.cellOffset > file.GetSize() || header.cellSize > file.GetSize() - header.cellOffset) return false;
+    if (header.tempOffset > file.GetSize() || header.tempSize > file.GetSize() - header.tempOffset) return false;
+    if (header.chunkOffset > file.GetSize() || header.chunkSize > file.GetSize() - header.chunkOffset) return false;
+    if (header.coarseOffset > file.GetSize() || header.coarseSize > file.GetSize() - header.coarseOffset) return false;
+    return true;
+}
+
+bool ReadInfo(const std::string& path, Info& info) {
+    MappedFile file;
+    FileHeader header;
+    if (!file.Open(path) || !ParseHeader(file, header)) return false;
+
+    info.version = header.version;
+    info.width = (int)header.width;
+    info.height = (int)header.height;
+    info.seed = header.seed;
+    info.tick = header.tick;
+    info.cellEncoding = (Encoding)header.cellEncoding;
+    info.tempEncoding = (Encoding)header.tempEncoding;
+    info.tempBytes = header.tempBytes;
+    return true;
+}
+
+bool Load(const std::string& path, World& world) {
+    MappedFile file;
+    FileHeader header;
+    if (!file.Open(path) || !ParseHeader(file, header)) return false;
+    if ((int)header.width != world.GetWidth() || (int)header.height != world.GetHeight()) return false;
+
+    std::size_t count = (std::size_t)header.width * header.height;
+    Reader cellIn = { file.GetData() + header.cellOffset, file.GetData() + header.cellOffset + header.cellSize };
+    Reader tempIn = { file.GetData() + header.tempOffset, file.GetData() + header.tempOffset + header.tempSize };
+
+    //! Validate both sections before touching the world
+    if (header.cellEncoding == ENCODING_RAW) {
+        if (header.cellSize != count * sizeof(CellType)) return false;
+        for (const std::uint8_t* p = cellIn.p; p < cellIn.end; p++) if (!IsSimElement(*p)) return false;
+    }
+    else if (header.cellEncoding != ENCODING_RLE || !DecodeCells(cellIn, nullptr, count)) return false;
+
+    if (header.tempEncoding == ENCODING_RAW) {
+        if ((header.tempBytes != 2 && header.tempBytes != 4) || header.tempSize != count * header.tempBytes) return false;
+    }
+    else if (header.tempEncoding != ENCODING_RLE || !DecodeTemps(tempIn, nullptr, count)) return false;
+
+    //! Pending rects are only usable with the same chunk grid, and must stay inside their chunks.
+    //! Version 1 files hold one rect per chunk, which scheduled both movement and heat.
+    std::vector<std::int32_t> pending;
+    std::size_t chunkCount = world.GetChunks().size();
+    int fileInts = header.version == 1 ? 4 : World::PENDING_INTS;
+    if (header.chunkShift == World::CHUNK_SHIFT && header.chunkSize == (std::uint64_t)chunkCount * fileInts * sizeof(std::int32_t)) {
+        pending.resize(chunkCount * World::PENDING_INTS);
+        const std::uint8_t* src = file.GetData() + header.chunkOffset;
+        for (std::size_t idx = 0; idx < chunkCount; idx++) {
+            std::int32_t* r = &pending[idx * World::PENDING_INTS];
+            std::memcpy(r, src + idx * fileInts * sizeof(std::int32_t), fileInts * sizeof(std::int32_t));
+            if (fileInts == 4) std::copy_n(r, 4, r + 4);
+        }
+
+        //! A rect is asleep only with both axes empty (Chunk::IsAwake() looks at X alone), and is
+        //! then stored the way the World writes it
+        for (std::size_t idx = 0; idx < pending.size() / 4 && !pending.empty(); idx++) {
+            std::int32_t* r = &pending[idx * 4];
+            std::size_t chunk = idx * 4 / World::PENDING_INTS;
+            int x0 = (int)(chunk % world.GetChunksX()) * World::CHUNK_SIZE;
+            int y0 = (int)(chunk / world.GetChunksX()) * World::CHUNK_SIZE;
+            bool asleep = r[0] > r[2] && r[1] > r[3];
+            bool inside = r[0] >= x0 && r[0] <= r[2] && r[2] < x0 + World::CHUNK_SIZE && r[2] < world.GetWidth() &&
+                          r[1] >= y0 && r[1] <= r[3] && r[3] < y0 + World::CHUNK_SIZE && r[3] < world.GetHeight();
+            if (asleep) {
+                r[0] = r[1] = INT_MAX;
+                r[2] = r[3] = INT_MIN;
+            }
+            else if (!inside) pending.clear();
+        }
+    }
+
+    //! Pending coarse heat is only usable with the same chunk grid; the values must be finite
+    std::vector<float> coarsePending;
+    if (header.chunkShift == World::CHUNK_SHIFT && header.coarseSize == (std::uint64_t)chunkCount * sizeof(float)) {
+        coarsePending.resize(chunkCount);
+        std::memcpy(coarsePending.data(), file.GetData() + header.coarseOffset, (size_t)header.coarseSize);
+        for (float v : coarsePending) if (!std::isfinite(v)) { coarsePending.clear(); break; }
+    }
+
+    //! Decode (or copy) straight from the mapping into the grid buffers; tiled grids go through
+    //! row-major scratch
+    std::vector<CellType> cellRows;
+    std::vector<CellTemp> tempRows;
+    CellType* cells = world.GetGridBuffer();
+    CellTemp* temps = world.GetTempBuffer();
+    if constexpr (GridLayout::TILED) {
+        cellRows.resize(count);
+        tempRows.resize(count);
+        cells = cellRows.data();
+        temps = tempRows.data();
+    }
+
+    if (header.cellEncoding == ENCODING_RAW) std::memcpy(cells, cellIn.p, count * sizeof(CellType));
+    else DecodeCells(cellIn, cells, count);
+
+    if (header.tempEncoding == ENCODING_RAW) CopyRawTemps(tempIn.p, header.tempBytes, temps, count);
+    else DecodeTemps(tempIn, temps, count);
+
+    if constexpr (GridLayout::TILED) {
+        world.GetLayout().FromRowMajor(cellRows.data(), world.GetGridBuffer());
+        world.GetLayout().FromRowMajor(tempRows.data(), world.GetTempBuffer());
+    }
+
+    world.Restore(header.seed, header.tick, pending.empty() ? nullptr : pending.data(),
+        coarsePending.empty() ? nullptr : coarsePending.data());
+    return true;
+}
+
+}
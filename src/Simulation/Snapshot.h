@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "World.h"
+
+//! Versioned binary snapshots of a World: dimensions, seed, tick, element IDs and temperatures.
+//!
+//! Layout (little-endian): a 104-byte header followed by the cell, temperature, chunk and
+//! coarse heat sections, each starting on a 64-byte boundary. The chunk section holds the
+//! pending movement and heat rectangles and the coarse section the block changes the coarse
+//! heat mode has not handed to the cells yet (one float per chunk, empty when the mode is off),
+//! so a loaded world continues exactly as the saved one would have.
+//!  - Compressed (default): IDs as runs of (id byte, varint length - 1); temperatures quantized
+//!    to 16 bits over MIN_TEMP..MAX_TEMP and stored as runs of (varint length - 1, zigzag varint
+//!    delta). Lossless for DINO_COMPACT_TEMP builds, ~0.08 degree steps for float builds.
+//!  - Raw: the grid buffers as they are in memory, for the fastest restore.
+//! Cells are always in row-major order, so files move between row-major and tiled builds.
+//! Files are loaded through a memory mapping and decoded (or copied) straight into the grid.
+namespace Snapshot {
+
+    const std::uint32_t MAGIC = 0x504E5344;  //! "DSNP"
+    //! 2: pending heat rects next to the movement rects (version 1 files still load)
+    //! 3: coarse heat section (version 1 and 2 files load with nothing pending)
+    const std::uint32_t VERSION = 3;
+
+    enum Encoding : std::uint32_t {
+        ENCODING_RAW = 0,   //! In-memory layout
+        ENCODING_RLE = 1    //! Run-length encoded (see above)
+    };
+
+    //! Header fields of a snapshot file
+    struct Info {
+        std::uint32_t version;
+        int width, height;
+        std::uint32_t seed;
+        std::uint32_t tick;
+        Encoding cellEncoding;
+        Encoding tempEncoding;
+        std::uint32_t tempBytes;    //! Bytes per raw temperature (4 = float, 2 = 16-bit fixed point)
+    };
+
+    //! Writes 'world' to 'path'; false on I/O errors
+    bool Save(const World& world, const std::string& path, bool compress = true);
+
+    //! Reads the header only (e.g. to size the World before Load)
+    bool ReadInfo(const std::string& path, Info& info);
+
+    //! Restores 'world' from 'path'. The world must have the snapshot's dimensions.
+    //! On failure (missing, truncated or foreign file, size mismatch) the world is left unchanged.
+    bool Load(const std::string& path, World& world);
+}
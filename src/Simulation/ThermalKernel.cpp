@@ -0,0 +1,176 @@
+#include "ThermalKernel.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DINO_THERMAL_SSE2
+#endif
+
+//! --- LANE TRAITS ---
+//! Minimal float-vector vocabulary the stencil is written against.
+//! Mask is the result of a comparison; Select(m, a, b) picks a where m is set.
+
+struct ScalarLanes {
+    static const int WIDTH = 1;
+    using F = float;
+    using Mask = bool;
+
+    static F Load(const float* p) { return *p; }
+    static void Store(float* p, F v) { *p = v; }
+    static F Set(float v) { return v; }
+    static F Add(F a, F b) { return a + b; }
+    static F Sub(F a, F b) { return a - b; }
+    static F Mul(F a, F b) { return a * b; }
+    static F Min(F a, F b) { return a < b ? a : b; }
+    static F Max(F a, F b) { return a > b ? a : b; }
+    static F Abs(F a) { return std::fabs(a); }
+    static Mask Greater(F a, F b) { return a > b; }
+    static F Select(Mask m, F a, F b) { return m ? a : b; }
+    static int Bits(Mask m) { return m ? 1 : 0; }
+};
+
+#if defined(__AVX2__)
+struct AvxLanes {
+    static const int WIDTH = 8;
+    using F = __m256;
+    using Mask = __m256;
+
+    static F Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static F Set(float v) { return _mm256_set1_ps(v); }
+    static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F Min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F Abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Mask Greater(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static F Select(Mask m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+    static int Bits(Mask m) { return _mm256_movemask_ps(m); }
+};
+using VectorLanes = AvxLanes;
+#elif defined(DINO_THERMAL_SSE2)
+struct SseLanes {
+    static const int WIDTH = 4;
+    using F = __m128;
+    using Mask = __m128;
+
+    static F Load(const float* p) { return _mm_loadu_ps(p); }
+    static void Store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static F Set(float v) { return _mm_set1_ps(v); }
+    static F Add(F a, F b) { return _mm_add_ps(a, b); }
+    static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F Min(F a, F b) { return _mm_min_ps(a, b); }
+    static F Max(F a, F b) { return _mm_max_ps(a, b); }
+    static F Abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static Mask Greater(F a, F b) { return _mm_cmpgt_ps(a, b); }
+    static F Select(Mask m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static int Bits(Mask m) { return _mm_movemask_ps(m); }
+};
+using VectorLanes = SseLanes;
+#else
+using VectorLanes = ScalarLanes;
+#endif
+
+//! --- STENCIL ---
+
+//! Heat flowing into cell 'c' from neighbor 'n' (negative when 'c' is the warmer one).
+//! Branch-free form of the original scenario rules:
+//!   A: both gas                    -> max conductivity, rate 0.25
+//!   B: gas next to a moving cell   -> max conductivity, rate 0.15
+//!   C: anything else (walls etc.)  -> mean conductivity, rate 0.05
+//!   Radiation: +0.1 between non-static cells more than 800 degrees apart
+//! The warmer side gives up only 'loss' of what the colder side gains (Fire gives up nothing).
+template <typename L>
+static inline typename L::F Flux(const ThermalTile& t, int c, int n, typename L::F tc, typename L::F loss) {
+    using F = typename L::F;
+
+    F tn = L::Load(t.temp + n);
+    F d = L::Sub(tn, tc);
+
+    F gc = L::Load(t.gas + c), gn = L::Load(t.gas + n);
+    F mc = L::Load(t.moving + c), mn = L::Load(t.moving + n);
+    F cc = L::Load(t.cond + c), cn = L::Load(t.cond + n);
+
+    F fast = L::Max(L::Mul(gc, mn), L::Mul(gn, mc));  //! Scenario A or B
+    F both = L::Mul(gc, gn);                           //! Scenario A
+
+    F mean = L::Mul(L::Add(cc, cn), L::Set(0.5f));
+    F conductivity = L::Add(mean, L::Mul(fast, L::Sub(L::Max(cc, cn), mean)));
+
+    F rate = L::Add(L::Set(0.05f), L::Mul(L::Add(fast, both), L::Set(0.1f)));
+    F radiation = L::Select(L::Greater(L::Abs(d), L::Set(800.0f)), L::Mul(L::Mul(mc, mn), L::Set(0.1f)), L::Set(0.0f));
+    rate = L::Add(rate, radiation);
+
+    F share = L::Select(L::Greater(d, L::Set(0.0f)), L::Set(1.0f), loss);
+    return L::Mul(L::Mul(d, L::Mul(conductivity, rate)), share);
+}
+
+//! Processes cells [begin, end) of a tile row, WIDTH lanes at a time
+template <typename L>
+static int DiffuseSpan(const ThermalTile& t, int rowStart, int begin, int end, float* out, int& firstChanged, int& lastChanged) {
+    using F = typename L::F;
+    const int up = -ThermalTile::STRIDE, down = ThermalTile::STRIDE;
+
+    int x = begin;
+    for (; x + L::WIDTH <= end; x += L::WIDTH) {
+        int c = rowStart + x;
+        F tc = L::Load(t.temp + c);
+        F loss = L::Load(t.loss + c);
+
+        //! 1. Diffusion
+        F next = tc;
+        next = L::Add(next, Flux<L>(t, c, c - 1, tc, loss));
+        next = L::Add(next, Flux<L>(t, c, c + 1, tc, loss));
+        next = L::Add(next, Flux<L>(t, c, c + up, tc, loss));
+        next = L::Add(next, Flux<L>(t, c, c + down, tc, loss));
+
+        //! 2. Cooling towards ambient
+        next = L::Sub(next, L::Mul(L::Sub(next, L::Set(AMBIENT_TEMP)), L::Load(t.cool + c)));
+
+        //! 3. Safety clamp
+        next = L::Min(L::Max(next, L::Set(MIN_TEMP)), L::Set(MAX_TEMP));
+
+        L::Store(out + x, next);
+
+        //! Settled lanes let the chunk sleep: a lane is settled once it stopped changing and is
+        //! back at ambient (slow cooling changes less than THERMAL_EPSILON per tick long before)
+        int bits = L::Bits(L::Greater(L::Abs(L::Sub(next, tc)), L::Set(THERMAL_EPSILON))) |
+                   L::Bits(L::Greater(L::Abs(L::Sub(tc, L::Set(AMBIENT_TEMP))), L::Set(AMBIENT_EPSILON)));
+        if (bits) {
+            int lo = 0, hi = L::WIDTH - 1;
+            while (!(bits & (1 << lo))) lo++;
+            while (!(bits & (1 << hi))) hi--;
+            if (firstChanged > lastChanged) firstChanged = x + lo;
+            lastChanged = x + hi;
+        }
+    }
+    return x;
+}
+
+namespace ThermalKernel {
+
+    const char* GetInstructionSet() {
+#if defined(__AVX2__)
+        return "AVX2";
+#elif defined(DINO_THERMAL_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    void DiffuseRow(const ThermalTile& tile, int row, int count, float* out, int& firstChanged, int& lastChanged) {
+        //! Row starts at the first interior cell; tile column x maps to out[x]
+        int rowStart = (row + 1) * ThermalTile::STRIDE + 1;
+
+        firstChanged = 1;
+        lastChanged = 0;
+
+        int done = DiffuseSpan<VectorLanes>(tile, rowStart, 0, count, out, firstChanged, lastChanged);
+        DiffuseSpan<ScalarLanes>(tile, rowStart, done, count, out, firstChanged, lastChanged);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "World.h"
+
+//! Shared thermodynamics constants
+//! (MIN_TEMP / MAX_TEMP live in CellFormat.h next to the temperature encoding)
+const float AMBIENT_TEMP = 22.0f;
+
+//! Per-tick temperature change below which a cell counts as settled (lets chunks sleep), once it
+//! is also within AMBIENT_EPSILON of ambient.
+//! Compact temperatures carry up to half a step of rounding noise, which must not keep chunks awake;
+//! stochastic rounding still brings them to the ambient code. Float temperatures stall a few
+//! thousandths of a degree off ambient, where the last cooling steps round away.
+#ifdef DINO_COMPACT_TEMP
+const float THERMAL_EPSILON = 0.5f / TEMP_SCALE;
+const float AMBIENT_EPSILON = 0.5f / TEMP_SCALE;
+#else
+const float THERMAL_EPSILON = 0.001f;
+const float AMBIENT_EPSILON = 0.01f;
+#endif
+
+//! Padded working set for the heat stencil of one chunk rectangle (Structure of Arrays).
+//! Cell (x, y) of the rectangle lives at (y + 1) * STRIDE + (x + 1); the one-cell border
+//! holds the neighbors (edge cells of the world are replicated so they add no flux).
+struct ThermalTile {
+    static const int STRIDE = World::CHUNK_SIZE + 2;
+    static const int SIZE = STRIDE * STRIDE;
+
+    float temp[SIZE];
+    float cond[SIZE];       //! Heat conductivity
+    float gas[SIZE];        //! 1 = gas, 0 = otherwise
+    float moving[SIZE];     //! 1 = powder/liquid/gas, 0 = static
+    float loss[SIZE];       //! Share of outgoing heat a cell gives up (0.5, or 0 for fire)
+    float cool[SIZE];       //! Cooling rate towards ambient (state factor included)
+};
+
+namespace ThermalKernel {
+
+    //! Name of the instruction set the kernel was compiled for ("AVX2", "SSE2" or "scalar")
+    const char* GetInstructionSet();
+
+    //! Diffuses, cools and clamps 'count' cells of tile row 'row' (0-based inside the rectangle).
+    //! Writes the new temperatures to 'out' and returns the [first, last] column that changed
+    //! or is not yet at ambient (first > last when the row is settled).
+    void DiffuseRow(const ThermalTile& tile, int row, int count, float* out, int& firstChanged, int& lastChanged);
+}
@@ -1,16 +1,197 @@
 #include "World.h"
 #include "Elements.h"
 #include "ReactionManager.h"
-#include "raylib.h" 
+#include "ThermalKernel.h"
+#include "CoarseHeat.h"
+#include "Random.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
 #include <algorithm> 
+#include <climits>
+#include <cmath>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-const float AMBIENT_TEMP = 22.0f;
+//! Random stream of each kind of work unit (see Random::SetStream)
+enum RandomPhase {
+    RNG_THERMAL = 0,        //! Per chunk: heat sources, temperature rounding
+    RNG_PHASE_CHANGE = 1,   //! Phase-change rolls after diffusion
+    RNG_PARTICLES = 2,      //! Per chunk row: powders & liquids
+    RNG_GASES = 3           //! Per chunk row: gases
+};
 
-World::World(int w, int h) : width(w), height(h) {
-    grid.resize(w * h, EMPTY);
-    nextGrid.resize(w * h, EMPTY);
-    gridTemp.resize(w * h, AMBIENT_TEMP);
-    nextGridTemp.resize(w * h, AMBIENT_TEMP);
+//! Encoded ambient temperature left behind by moving particles
+static const CellTemp AMBIENT_CELL_TEMP = EncodeTemp(AMBIENT_TEMP);
+
+//! Counters of the running phase on this thread, merged into the World's tallies by FlushCounters()
+static thread_local TickCounters threadCounters;
+
+static_assert(World::CHUNK_SIZE == 32, "Plane words hold one chunk row");
+static_assert(GridLayout::TILE_SIZE == World::CHUNK_SIZE, "Tiles hold one chunk");
+
+//! Lowest / highest set bit of a non-zero word
+static inline int LowestBit(std::uint32_t v) {
+#ifdef _MSC_VER
+    unsigned long bit; _BitScanForward(&bit, v); return (int)bit;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+static inline int HighestBit(std::uint32_t v) {
+#ifdef _MSC_VER
+    unsigned long bit; _BitScanReverse(&bit, v); return (int)bit;
+#else
+    return 31 - __builtin_clz(v);
+#endif
+}
+
+//! Encoded temperatures a cell may hold and still count as ambient (see World::IsAmbientRect)
+static const CellTemp AMBIENT_LOW = EncodeTemp(AMBIENT_TEMP - AMBIENT_EPSILON);
+static const CellTemp AMBIENT_HIGH = EncodeTemp(AMBIENT_TEMP + AMBIENT_EPSILON);
+
+//! Heat stencil output to storage. Compact temperatures round stochastically, except within
+//! AMBIENT_EPSILON of ambient: there they snap to the ambient code, since flickering between the
+//! codes around it would never settle (the lossy stencil turns the flicker into heat).
+static inline CellTemp EncodeDiffused(float t) {
+#ifdef DINO_COMPACT_TEMP
+    if (std::fabs(t - AMBIENT_TEMP) <= AMBIENT_EPSILON) return AMBIENT_CELL_TEMP;
+#endif
+    return EncodeTempDithered(t);
+}
+
+//! Puts every rectangle of a chunk to sleep
+static void SleepChunk(Chunk& c) {
+    c.minX = c.minY = c.nextMinX = c.nextMinY = INT_MAX;
+    c.maxX = c.maxY = c.nextMaxX = c.nextMaxY = INT_MIN;
+    c.heatMinX = c.heatMinY = c.nextHeatMinX = c.nextHeatMinY = INT_MAX;
+    c.heatMaxX = c.heatMaxY = c.nextHeatMaxX = c.nextHeatMaxY = INT_MIN;
+    c.warm = false;
+}
+
+World::World(int w, int h) : width(w), height(h), layout(w, h) {
+    std::size_t cells = layout.GetCellCount();
+    grid.resize(cells, EMPTY);
+    gridTemp.resize(cells, AMBIENT_CELL_TEMP);
+    thermalScratch.resize(cells, AMBIENT_CELL_TEMP);
+    moved.resize(cells, 0);
+
+    chunksX = (w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (h + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunks = std::vector<Chunk>(chunksX * chunksY);
+    for (Chunk& c : chunks) SleepChunk(c);
+    chunkEpochs.assign(chunks.size(), 0);
+    planes.reset(new std::atomic<std::uint32_t>[(std::size_t)chunksX * h * PLANE_COUNT]());
+
+    thermalTile = std::make_unique<ThermalTile>();
+    BuildKernelTables();
+}
+
+World::~World() = default;
+
+void World::SetThreadCount(int threads) {
+    if (threads <= 1) pool.reset();
+    else if (!pool || pool->GetThreadCount() != threads) pool = std::make_unique<ThreadPool>(threads);
+}
+
+int World::GetThreadCount() const {
+    return pool ? pool->GetThreadCount() : 1;
+}
+
+void World::SetCoarseHeat(bool enabled) {
+    if (!enabled) coarseHeat.reset();
+    else if (!coarseHeat) coarseHeat = std::make_unique<CoarseHeat>(chunksX, chunksY);
+}
+
+void World::MarkDirtyRect(int minX, int minY, int maxX, int maxY, WakeFlags wake) {
+    int x0 = std::max(minX - 1, 0);
+    int x1 = std::min(maxX + 1, width - 1);
+    int y0 = std::max(minY - 1, 0);
+    int y1 = std::min(maxY + 1, height - 1);
+
+    //! The grown rectangle usually lies in one chunk
+    for (int cy = y0 >> CHUNK_SHIFT; cy <= (y1 >> CHUNK_SHIFT); cy++) {
+        int top = cy << CHUNK_SHIFT;
+        for (int cx = x0 >> CHUNK_SHIFT; cx <= (x1 >> CHUNK_SHIFT); cx++) {
+            int left = cx << CHUNK_SHIFT;
+            chunks[cy * chunksX + cx].Wake(std::max(x0, left), std::max(y0, top),
+                std::min(x1, left + CHUNK_SIZE - 1), std::min(y1, top + CHUNK_SIZE - 1), wake);
+        }
+    }
+}
+
+bool World::IsAmbientRect(int minX, int minY, int maxX, int maxY) const {
+    minX = std::max(minX, 0); maxX = std::min(maxX, width - 1);
+    minY = std::max(minY, 0); maxY = std::min(maxY, height - 1);
+
+    //! Branch-free within a run: moves check 3x4 or 4x4 blocks
+    bool ambient = true;
+    for (int y = minY; y <= maxY && ambient; y++) {
+        layout.ForEachRun(minX, y, maxX - minX + 1, [&](int index, int, int length) {
+            const CellTemp* run = &gridTemp[index];
+            for (int k = 0; k < length; k++) ambient &= (run[k] >= AMBIENT_LOW) & (run[k] <= AMBIENT_HIGH);
+        });
+    }
+    return ambient;
+}
+
+inline WakeFlags World::MoveWake(int x0, int y0, int x1, int y1) const {
+    //! The moved cell itself is warm (hot gases, lava): no need to look further
+    CellTemp carried = gridTemp[layout.Index(x1, y1)];
+    if (carried < AMBIENT_LOW || carried > AMBIENT_HIGH) return WAKE_ALL;
+
+    int minX = std::max(std::min(x0, x1) - 1, 0), maxX = std::min(std::max(x0, x1) + 1, width - 1);
+    int minY = std::max(std::min(y0, y1) - 1, 0), maxY = std::min(std::max(y0, y1) + 1, height - 1);
+
+    //! Fast path: the block spans at most 2x2 chunks, none of them with warm cells
+    int c0 = (minY >> CHUNK_SHIFT) * chunksX, c1 = (maxY >> CHUNK_SHIFT) * chunksX;
+    int cx0 = minX >> CHUNK_SHIFT, cx1 = maxX >> CHUNK_SHIFT;
+    bool warm = chunks[c0 + cx0].warm.load(std::memory_order_relaxed) | chunks[c0 + cx1].warm.load(std::memory_order_relaxed) |
+                chunks[c1 + cx0].warm.load(std::memory_order_relaxed) | chunks[c1 + cx1].warm.load(std::memory_order_relaxed);
+
+    return !warm || IsAmbientRect(minX, minY, maxX, maxY) ? WAKE_MOTION : WAKE_ALL;
+}
+
+void World::BeginTick() {
+    activeCells = heatCells = 0;
+    for (std::vector<int>& list : phaseChunks) list.clear();
+
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        Chunk& c = chunks[idx];
+        bool wasHeatAwake = c.IsHeatAwake();
+        c.minX = c.nextMinX; c.maxX = c.nextMaxX;
+        c.minY = c.nextMinY; c.maxY = c.nextMaxY;
+        c.heatMinX = c.nextHeatMinX; c.heatMaxX = c.nextHeatMaxX;
+        c.heatMinY = c.nextHeatMinY; c.heatMaxY = c.nextHeatMaxY;
+
+        c.nextMinX = c.nextMinY = c.nextHeatMinX = c.nextHeatMinY = INT_MAX;
+        c.nextMaxX = c.nextMaxY = c.nextHeatMaxX = c.nextHeatMaxY = INT_MIN;
+
+        if (c.IsHeatAwake()) heatCells += (c.heatMaxX - c.heatMinX + 1) * (c.heatMaxY - c.heatMinY + 1);
+
+        //! Temperatures just settled: find out whether the chunk is back at ambient
+        else if (wasHeatAwake && c.warm) {
+            int left = (idx % chunksX) << CHUNK_SHIFT, top = (idx / chunksX) << CHUNK_SHIFT;
+            c.warm = !IsAmbientRect(left, top, left + CHUNK_SIZE - 1, top + CHUNK_SIZE - 1);
+        }
+        if (!c.IsAwake()) continue;
+        activeCells += (c.maxX - c.minX + 1) * (c.maxY - c.minY + 1);
+
+        //! Checkerboard color from the chunk's column/row parity
+        if (pool) {
+            int cx = idx % chunksX;
+            int cy = idx / chunksX;
+            phaseChunks[(cx & 1) | ((cy & 1) << 1)].push_back(idx);
+        }
+    }
+}
+
+void World::NextMoveStamp() {
+    if (++moveStamp == 0) {
+        std::fill(moved.begin(), moved.end(), 0);
+        moveStamp = 1;
+    }
 }
 
 bool World::IsValid(int index) const {
@@ -18,14 +199,12 @@ bool World::IsValid(int index) const {
 }
 
 void World::SetCell(int index, int type) {
-    if (IsValid(index)) {
-        nextGrid[index] = type;
-        grid[index] = type;
-
-        const ElementDef& def = GetElementDef(type);
+    //! Tool IDs never enter the grid
+    if (IsValid(index) && IsSimElement(type)) {
+        WriteCell(index, type);
+        gridTemp[index] = EncodeTemp(elementTable.baseTemp[type]);
 
-        gridTemp[index] = def.baseTemp;
-        nextGridTemp[index] = def.baseTemp;
+        MarkDirty(index);
     }
 }
 
@@ -34,241 +213,877 @@ int World::GetCell(int index) const {
     return EMPTY;
 }
 
-float World::GetTemp(int index) const { if (IsValid(index)) return gridTemp[index]; return AMBIENT_TEMP; }
+float World::GetTemp(int index) const { if (IsValid(index)) return DecodeTemp(gridTemp[index]); return AMBIENT_TEMP; }
+
+void World::SetTemp(int index, float temp) {
+    if (IsValid(index)) {
+        gridTemp[index] = EncodeTemp(temp);
+        MarkDirty(index, WAKE_HEAT);
+    }
+}
+
+void World::FillSpan(int y, int x0, int x1, int type) {
+    CellTemp temp = EncodeTemp(elementTable.baseTemp[type]);
+    bool keepWalls = type != WALL && type != EMPTY;
+
+    //! One chunk row at a time (contiguous in every layout), with its plane words
+    for (int cx = x0 >> CHUNK_SHIFT; cx <= (x1 >> CHUNK_SHIFT); cx++) {
+        int left = cx << CHUNK_SHIFT;
+        int a = std::max(x0, left) - left;
+        int b = std::min(x1, left + CHUNK_SIZE - 1) - left;
+        std::uint32_t span = (b == CHUNK_SIZE - 1 ? ~0u : (1u << (b + 1)) - 1) & ~((1u << a) - 1);
+        int base = layout.Index(left, y);
+        CellType* cells = &grid[base];
+        CellTemp* temps = &gridTemp[base];
+
+        //! Plane bits: cells of 'type' and the walls left in place
+        std::uint32_t walls = 0;
+        if (keepWalls) {
+            for (int k = a; k <= b; k++) {
+                if (cells[k] == WALL) { walls |= 1u << k; continue; }
+                cells[k] = (CellType)type;
+                temps[k] = temp;
+            }
+        }
+        else {
+            std::fill(cells + a, cells + b + 1, (CellType)type);
+            std::fill(temps + a, temps + b + 1, temp);
+        }
+
+        std::atomic<std::uint32_t>* words = PlaneWords(y, cx);
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            std::uint32_t bits = (((planeBits[type] >> p) & 1u) ? span & ~walls : 0) | (((planeBits[WALL] >> p) & 1u) ? walls : 0);
+            words[p].store((words[p].load(std::memory_order_relaxed) & ~span) | bits, std::memory_order_relaxed);
+        }
+    }
+}
+
+void World::HeatSpan(int y, int x0, int x1, float delta) {
+    layout.ForEachRun(x0, y, x1 - x0 + 1, [&](int index, int, int length) {
+        const CellType* cells = &grid[index];
+        CellTemp* temps = &gridTemp[index];
+        for (int k = 0; k < length; k++) {
+            float scale = heatToolScale[cells[k]];
+            if (scale == 0.0f) continue;
+            float t = DecodeTemp(temps[k]) + delta * scale;
+            temps[k] = EncodeTemp(std::min(std::max(t, MIN_TEMP), MAX_TEMP));
+        }
+    });
+}
+
+//! x-range [lo, hi] of row y inside the capsule of radius r around (ax, ay)-(bx, by); false if the row misses it.
+//! The capsule is convex, so the row is one interval: the union of both end disks and the band between them.
+static bool CapsuleRow(float ax, float ay, float bx, float by, float r, float y, float& lo, float& hi) {
+    lo = INFINITY;
+    hi = -INFINITY;
+    for (int end = 0; end < 2; end++) {
+        float ex = end ? bx : ax, dy = y - (end ? by : ay);
+        if (dy * dy > r * r) continue;
+        float half = std::sqrt(r * r - dy * dy);
+        lo = std::min(lo, ex - half);
+        hi = std::max(hi, ex + half);
+    }
+
+    float dx = bx - ax, dy = by - ay;
+    float len2 = dx * dx + dy * dy;
+    if (len2 > 0.0f) {
+        //! Band: 0 <= (p - a).d <= |d|^2 and |(p - a) x d| <= r |d|, each an x-interval of the row
+        float py = y - ay, reach = r * std::sqrt(len2);
+        float a = -INFINITY, b = INFINITY;
+        if (dx != 0.0f) {
+            float t0 = -py * dy / dx, t1 = (len2 - py * dy) / dx;
+            a = std::max(a, std::min(t0, t1));
+            b = std::min(b, std::max(t0, t1));
+        }
+        else if (py * dy < 0.0f || py * dy > len2) b = -INFINITY;
+
+        if (dy != 0.0f) {
+            float t0 = (py * dx - reach) / dy, t1 = (py * dx + reach) / dy;
+            a = std::max(a, std::min(t0, t1));
+            b = std::min(b, std::max(t0, t1));
+        }
+        else if (std::fabs(py * dx) > reach) b = -INFINITY;
+
+        if (a <= b) {
+            lo = std::min(lo, ax + a);
+            hi = std::max(hi, ax + b);
+        }
+    }
+    return lo <= hi;
+}
+
+template <typename SpanOp>
+void World::ForEachStrokeSpan(int x0, int y0, int x1, int y1, int radius, WakeFlags wake, SpanOp spanOp) {
+    //! Cell centers within radius + 0.5: a radius 0 stroke is a connected line
+    float r = std::max(radius, 0) + 0.5f;
+    int top = std::max(std::min(y0, y1) - radius, 0);
+    int bottom = std::min(std::max(y0, y1) + radius, height - 1);
+
+    int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
+    for (int y = top; y <= bottom; y++) {
+        float lo, hi;
+        if (!CapsuleRow((float)x0, (float)y0, (float)x1, (float)y1, r, (float)y, lo, hi)) continue;
+        int left = std::max((int)std::ceil(lo), 0);
+        int right = std::min((int)std::floor(hi), width - 1);
+        if (left > right) continue;
+
+        spanOp(y, left, right);
+        minX = std::min(minX, left); maxX = std::max(maxX, right);
+        minY = std::min(minY, y); maxY = std::max(maxY, y);
+    }
+    if (minX <= maxX) MarkDirtyRect(minX, minY, maxX, maxY, wake);
+}
+
+void World::FillRect(int minX, int minY, int maxX, int maxY, int type) {
+    if (!IsSimElement(type)) return;
+    minX = std::max(minX, 0); maxX = std::min(maxX, width - 1);
+    minY = std::max(minY, 0); maxY = std::min(maxY, height - 1);
+    if (minX > maxX || minY > maxY) return;
+
+    for (int y = minY; y <= maxY; y++) FillSpan(y, minX, maxX, type);
+    MarkDirtyRect(minX, minY, maxX, maxY);
+}
+
+void World::FillCircle(int cx, int cy, int radius, int type) {
+    PaintStroke(cx, cy, cx, cy, radius, type);
+}
+
+void World::PaintStroke(int x0, int y0, int x1, int y1, int radius, int type) {
+    if (!IsSimElement(type)) return;
+    ForEachStrokeSpan(x0, y0, x1, y1, radius, WAKE_ALL, [&](int y, int left, int right) { FillSpan(y, left, right, type); });
+}
 
-void World::SetTemp(int index, float temp) { if (IsValid(index)) { gridTemp[index] = temp; nextGridTemp[index] = temp; } }
+void World::ApplyHeatRegion(int cx, int cy, int radius, float delta) {
+    ForEachStrokeSpan(cx, cy, cx, cy, radius, WAKE_HEAT, [&](int y, int left, int right) { HeatSpan(y, left, right, delta); });
+}
 
 void World::Reset() {
     std::fill(grid.begin(), grid.end(), EMPTY);
-    std::fill(nextGrid.begin(), nextGrid.end(), EMPTY);
-    std::fill(gridTemp.begin(), gridTemp.end(), AMBIENT_TEMP);
-    std::fill(nextGridTemp.begin(), nextGridTemp.end(), AMBIENT_TEMP);
+    std::fill(gridTemp.begin(), gridTemp.end(), AMBIENT_CELL_TEMP);
+    RebuildPlanes();
+
+    //! A uniform empty world has nothing to simulate
+    for (Chunk& c : chunks) SleepChunk(c);
+    if (coarseHeat) coarseHeat->Reset();
+
+    //! ...but every chunk has to be redrawn
+    changeEpoch++;
+    std::fill(chunkEpochs.begin(), chunkEpochs.end(), changeEpoch);
+
+    //! Replays restart from tick 0
+    tick = 0;
+}
+
+void World::Restore(std::uint32_t newSeed, std::uint32_t newTick, const std::int32_t* pending, const float* coarsePending) {
+    seed = newSeed;
+    tick = newTick;
+    RebuildPlanes();
+    if (coarseHeat) coarseHeat->Reset(coarsePending);
+
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        int left = (idx % chunksX) << CHUNK_SHIFT, top = (idx / chunksX) << CHUNK_SHIFT;
+        chunks[idx].warm = !IsAmbientRect(left, top, left + CHUNK_SIZE - 1, top + CHUNK_SIZE - 1);
+    }
+
+    if (pending) {
+        for (int idx = 0; idx < (int)chunks.size(); idx++) {
+            Chunk& c = chunks[idx];
+            const std::int32_t* r = pending + idx * PENDING_INTS;
+            c.nextMinX = r[0]; c.nextMinY = r[1];
+            c.nextMaxX = r[2]; c.nextMaxY = r[3];
+            c.nextHeatMinX = r[4]; c.nextHeatMinY = r[5];
+            c.nextHeatMaxX = r[6]; c.nextHeatMaxY = r[7];
+        }
+    }
+    //! Nothing is known about the new contents: simulate everything once
+    else MarkDirtyRect(0, 0, width - 1, height - 1);
+
+    changeEpoch++;
+    std::fill(chunkEpochs.begin(), chunkEpochs.end(), changeEpoch);
+}
+
+void World::RebuildPlanes() {
+    for (int y = 0; y < height; y++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            int left = cx << CHUNK_SHIFT;
+            int right = std::min(left + CHUNK_SIZE, width);
+            const CellType* cells = &grid[layout.Index(left, y)];
+            std::uint32_t bits[PLANE_COUNT] = {};
+            for (int k = 0; k < right - left; k++) {
+                unsigned int member = planeBits[cells[k]];
+                for (int p = 0; p < PLANE_COUNT; p++) bits[p] |= ((member >> p) & 1u) << k;
+            }
+            std::atomic<std::uint32_t>* words = PlaneWords(y, cx);
+            for (int p = 0; p < PLANE_COUNT; p++) words[p].store(bits[p], std::memory_order_relaxed);
+        }
+    }
+}
+
+void World::GetCoarsePending(std::vector<float>& values) const {
+    if (coarseHeat) values = coarseHeat->pending;
+    else values.clear();
+}
+
+void World::GetPendingRects(std::vector<std::int32_t>& rects) const {
+    rects.resize(chunks.size() * PENDING_INTS);
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        const Chunk& c = chunks[idx];
+        std::int32_t* r = &rects[idx * PENDING_INTS];
+        r[0] = c.nextMinX.load(std::memory_order_relaxed);
+        r[1] = c.nextMinY.load(std::memory_order_relaxed);
+        r[2] = c.nextMaxX.load(std::memory_order_relaxed);
+        r[3] = c.nextMaxY.load(std::memory_order_relaxed);
+        r[4] = c.nextHeatMinX.load(std::memory_order_relaxed);
+        r[5] = c.nextHeatMinY.load(std::memory_order_relaxed);
+        r[6] = c.nextHeatMaxX.load(std::memory_order_relaxed);
+        r[7] = c.nextHeatMaxY.load(std::memory_order_relaxed);
+    }
+}
+
+void World::FlushCounters() {
+    if (threadCounters.cellsMoved) movedTally.fetch_add(threadCounters.cellsMoved, std::memory_order_relaxed);
+    if (threadCounters.reactions) reactionTally.fetch_add(threadCounters.reactions, std::memory_order_relaxed);
+    if (threadCounters.phaseChanges) phaseChangeTally.fetch_add(threadCounters.phaseChanges, std::memory_order_relaxed);
+    threadCounters = TickCounters();
 }
 
 void World::Update() {
-    nextGrid = grid;
-    nextGridTemp = gridTemp;
+    lastTimings = TickTimings();
+    movedTally = reactionTally = phaseChangeTally = 0;
+
+    {
+        //! --- PHASE 1: THERMODYNAMICS & PHASE CHANGE ---
+        ScopedTimer timer(lastTimings.thermo);
+        BeginTick();
+        UpdateThermodynamics();
+        FlushCounters();
+    }
+
+    {
+        //! --- PHASE 2: GENERAL PARTICLE PHYSICS ---
+        ScopedTimer timer(lastTimings.solids);
+        NextMoveStamp();
+        if (pool) UpdateParticlesParallel();
+        else UpdateParticles();
+        FlushCounters();
+    }
 
-    //! --- PHASE 1: THERMODYNAMICS & PHASE CHANGE ---
-    for (int i = 0; i < (int)grid.size(); i++) {
-        int type = grid[i];
-        float myTemp = gridTemp[i];
+    {
+        //! --- PHASE 3: GAS PHYSICS (Top-Down) ---
+        ScopedTimer timer(lastTimings.gases);
+        NextMoveStamp();
+        if (pool) UpdateGasesParallel();
+        else UpdateGases();
+        FlushCounters();
+    }
 
-        //! Get element properties safely
-        const ElementDef& myDef = GetElementDef(type);
+    lastCounters.cellsMoved = movedTally.load(std::memory_order_relaxed);
+    lastCounters.reactions = reactionTally.load(std::memory_order_relaxed);
+    lastCounters.phaseChanges = phaseChangeTally.load(std::memory_order_relaxed);
+    lastCounters.activeCells = activeCells;
+    lastCounters.heatCells = heatCells;
 
-        //! 1. Heat Sources
-        if (type == FIRE) {
-            nextGridTemp[i] = 2200.0f + GetRandomValue(0, 300);
-            myTemp = nextGridTemp[i];
+    //! Chunks processed this tick (including edits made before it) or touched by a neighbor
+    changeEpoch++;
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        const Chunk& c = chunks[idx];
+        if (c.IsAwake() || c.IsHeatAwake() ||
+            c.nextMinX.load(std::memory_order_relaxed) <= c.nextMaxX.load(std::memory_order_relaxed) ||
+            c.nextHeatMinX.load(std::memory_order_relaxed) <= c.nextHeatMaxX.load(std::memory_order_relaxed)) {
+            chunkEpochs[idx] = changeEpoch;
         }
+    }
 
-        //! 2. Heat Diffusion
-        int nbs[] = { i - 1, i + 1, i - width, i + width };
-
-        for (int n : nbs) {
-            if (IsValid(n)) {
-                float nTemp = gridTemp[n];
-
-                //! Only take action if the neighbor is warmer than me 
-                if (nTemp > myTemp) {
-                    const ElementDef& nDef = GetElementDef(grid[n]);
-                    float diff = nTemp - myTemp;
-
-                    //! --- CONDUCTIVITY AND RATIO CALCULATION ---
-                    float conductivity;
-                    float rate = 0.05f; //! Default slow speed
-
-                    bool amIGas = (myDef.state == STATE_GAS);
-                    bool neighborGas = (nDef.state == STATE_GAS);
-
-                    //! Static (Wall) control
-                    bool amIStatic = (myDef.state == STATE_STATIC);
-                    bool neighborStatic = (nDef.state == STATE_STATIC);
-
-                    //! SCENARIO A: We are both Gas (Air-Fire) -> Very Fast
-                    if (amIGas && neighborGas) {
-                        conductivity = std::max(myDef.heatConductivity, nDef.heatConductivity);
-                        rate = 0.25f; //! Gases mix very quickly
-                    }
-                    //! SCENARIO B: One of Us is Gas, the Other is "Moving Solid/Liquid" (Air-Sand) -> Fast
-                    else if ((amIGas && !neighborStatic) || (neighborGas && !amIStatic)) {
-                        conductivity = std::max(myDef.heatConductivity, nDef.heatConductivity);
-                        rate = 0.15f;
-                    }
-                    //! SCENARIO C: Wall Involved -> Slow (Insulation)
-                    else {
-                        conductivity = (myDef.heatConductivity + nDef.heatConductivity) * 0.5f;
-                        rate = 0.05f;
-                    }
-
-                    //! Radiation Bonus (Only if Not a Wall)
-                    if (!amIStatic && !neighborStatic && diff > 800.0f) {
-                        rate += 0.1f; //! Extra speed
-                    }
-
-                    //! Calculate Transfer
-                    float transfer = diff * conductivity * rate;
-
-                    //! Apply Heat 
-                    nextGridTemp[i] += transfer;
-
-                    //! Conservation of energy (Fire does not burn out, others cool down)
-                    if (grid[n] != FIRE) {
-                        nextGridTemp[n] -= transfer * 0.5f;
-                    }
-                }
+    tick++;
+}
+
+//! Per-element inputs of the heat stencil, derived once from the element table
+struct ThermalProps {
+    float cond, gas, moving, loss, cool;
+
+    //! Temperatures outside [cold, hot] make ReactionManager::IsUnstable() true
+    float hot, cold;
+};
+
+static const ThermalProps* GetThermalProps() {
+    static ThermalProps props[ELEMENT_COUNT];
+    static bool built = [] {
+        const ElementTable& table = elementTable;
+        for (int id = 0; id < ELEMENT_COUNT; id++) {
+            int state = table.state[id];
+            ThermalProps& p = props[id];
+
+            p.cond = table.conductivity[id];
+            p.gas = state == STATE_GAS ? 1.0f : 0.0f;
+            p.moving = state != STATE_STATIC ? 1.0f : 0.0f;
+            p.loss = id == FIRE ? 0.0f : 0.5f; //! Fire does not burn out
+            p.cool = table.coolingRate[id] * (state == STATE_GAS ? 1.0f : 0.5f);
+
+            p.hot = INFINITY;
+            p.cold = -INFINITY;
+            if (id == EMPTY || id == WALL) continue;
+            if (table.highTempConvert[id] != -1) p.hot = table.highTemp[id];
+            if (table.flammability[id] > 0) p.hot = std::min(p.hot, 300.0f);
+            if (table.lowTempConvert[id] != -1) p.cold = table.lowTemp[id];
+        }
+        return true;
+    }();
+    (void)built;
+    return props;
+}
+
+void World::UpdateThermodynamics() {
+    const ThermalProps* props = GetThermalProps();
+    ThermalTile& tile = *thermalTile;
+
+    unstableCells.clear();
+
+    for (int c = 0; c < (int)chunks.size(); c++) {
+        const Chunk& chunk = chunks[c];
+        if (!chunk.IsHeatAwake()) continue;
+
+        int minX = chunk.heatMinX, minY = chunk.heatMinY;
+        int w = chunk.heatMaxX - minX + 1;
+        int h = chunk.heatMaxY - minY + 1;
+
+        Random::SetStream(seed, tick, RNG_THERMAL, c);
+
+        //! 1. Gather the rectangle plus a one-cell border into the tile.
+        //! Coordinates are clamped, so world edges replicate themselves and exchange no heat.
+        for (int ty = 0; ty < h + 2; ty++) {
+            int y = std::min(std::max(minY + ty - 1, 0), height - 1);
+            bool interiorRow = ty > 0 && ty <= h;
+
+            for (int tx = 0; tx < w + 2; tx++) {
+                int x = std::min(std::max(minX + tx - 1, 0), width - 1);
+                int i = layout.Index(x, y);
+                int t = ty * ThermalTile::STRIDE + tx;
+                int type = grid[i];
+                const ThermalProps& p = props[type];
+
+                float temp = DecodeTemp(gridTemp[i]);
+
+                tile.temp[t] = temp;
+                tile.cond[t] = p.cond;
+                tile.gas[t] = p.gas;
+                tile.moving[t] = p.moving;
+                tile.loss[t] = p.loss;
+                tile.cool[t] = p.cool;
+
+                if (!interiorRow || tx == 0 || tx > w) continue;
+
+                //! Past a phase-change threshold: converted once every chunk is diffused
+                if (temp > p.hot || temp < p.cold) unstableCells.push_back(i);
+
+                //! Heat Sources
+                if (type == FIRE) tile.temp[t] = 2200.0f + Random::Range(0, 300);
             }
         }
 
-        //! 3. Cooling
-        float environmentFactor = 1.0f;
-        if (myDef.state != STATE_GAS) environmentFactor = 0.5f;
+        //! Bounds of the cells changed in this chunk, marked once at the end
+        int changedMinX = INT_MAX, changedMinY = INT_MAX;
+        int changedMaxX = INT_MIN, changedMaxY = INT_MIN;
+
+        //! 2. Diffusion, cooling and clamp in one vectorized sweep per row.
+        //! Results go to the scratch buffer so later chunks still read this tick's input.
+        for (int ty = 0; ty < h; ty++) {
+            int y = minY + ty;
+            int first, last;
+            float rowOut[CHUNK_SIZE];
+            ThermalKernel::DiffuseRow(tile, ty, w, rowOut, first, last);
 
-        float cooling = (nextGridTemp[i] - AMBIENT_TEMP) * myDef.coolingRate * environmentFactor;
+            //! The rectangle lies in one chunk, so its rows are contiguous
+            CellTemp* scratchRow = &thermalScratch[layout.Index(minX, y)];
+            for (int k = 0; k < w; k++) scratchRow[k] = EncodeDiffused(rowOut[k]);
 
-        nextGridTemp[i] -= cooling;
+            if (first <= last) {
+                changedMinX = std::min(changedMinX, minX + first); changedMaxX = std::max(changedMaxX, minX + last);
+                changedMinY = std::min(changedMinY, y); changedMaxY = std::max(changedMaxY, y);
+            }
+        }
+
+        //! Temperatures alone never move particles: only the heat schedule is woken
+        if (changedMinX <= changedMaxX) MarkDirtyRect(changedMinX, changedMinY, changedMaxX, changedMaxY, WAKE_HEAT);
+    }
 
-        //! 4. Phase Changes
-        if (type != EMPTY && type != WALL) {
-            ReactionManager::ProcessTemperature(*this, i);
+    //! 3. Copy the diffused rectangles back
+    for (const Chunk& chunk : chunks) {
+        if (!chunk.IsHeatAwake()) continue;
+        for (int y = chunk.heatMinY; y <= chunk.heatMaxY; y++) {
+            int rowStart = layout.Index(chunk.heatMinX, y);
+            std::copy_n(&thermalScratch[rowStart], chunk.heatMaxX - chunk.heatMinX + 1, &gridTemp[rowStart]);
         }
+    }
 
-        //! --- (SAFETY CLAMP) ---
-        if (nextGridTemp[i] > 5000.0f) nextGridTemp[i] = 5000.0f;
-        //! Abosulte Zero
-        if (nextGridTemp[i] < -273.0f) nextGridTemp[i] = -273.0f;
+    //! 4. Phase Changes (the roll may fail: unstable cells stay awake)
+    Random::SetStream(seed, tick, RNG_PHASE_CHANGE, 0);
+    for (int i : unstableCells) {
+        int before = grid[i];
+        ReactionManager::ProcessTemperature(*this, i);
+        if (grid[i] != before) threadCounters.phaseChanges++;
+        MarkDirty(i, WAKE_HEAT);
     }
 
-    //! --- PHASE 2: GENERAL PARTICLE PHYSICS ---
-    //! Iterating Bottom-Up for Solids and Liquids
-    for (int y = height - 1; y >= 0; y--) {
-        for (int x = 0; x < width; x++) {
-            int scanX = (y % 2 == 0) ? x : (width - 1 - x);
-            int i = y * width + scanX;
-            int type = grid[i];
-
-            if (type == EMPTY || type == WALL) continue;
-
-            const ElementDef& def = GetElementDef(type);
-            int state = def.state;
-
-            //! Skip statics and gases (handled elsewhere)
-            if (state == STATE_STATIC) continue;
-            if (state == STATE_GAS) continue;
-
-            //! Calculate neighbor indices
-            int below = i + width;
-            int belowL = i + width - 1;
-            int belowR = i + width + 1;
-
-            int target = -1;
-
-            if (y < height - 1) {
-                //! 1. Gravity (Fall down)
-                if (grid[below] == EMPTY && nextGrid[below] == EMPTY) target = below;
-
-                //! 2. Density Check (Sinking in liquids)
-                else if (state == STATE_POWDER) {
-                    int belowType = grid[below];
-                    if (GetElementDef(belowType).state == STATE_LIQUID && nextGrid[below] == belowType) {
-                        target = below;
-                        //! Swap particle and liquid
-                        nextGrid[below] = type; nextGrid[i] = belowType;
-                        //! Swap temperature
-                        float t = nextGridTemp[below]; nextGridTemp[below] = nextGridTemp[i]; nextGridTemp[i] = t;
-                        continue; //! Move handled, skip to next
-                    }
-                }
+    if (coarseHeat && tick % CoarseHeat::INTERVAL == 0) UpdateCoarseHeat();
+}
+
+//! Heat cell 'a' gains from cell 'b' in one tick of the heat stencil (ThermalKernel's Flux
+//! without radiation and without the warmer side's loss share)
+static inline float PairFlux(const ThermalProps& a, const ThermalProps& b, float ta, float tb) {
+    float fast = std::max(a.gas * b.moving, b.gas * a.moving);
+    float both = a.gas * b.gas;
+    float mean = (a.cond + b.cond) * 0.5f;
+    float conductivity = mean + fast * (std::max(a.cond, b.cond) - mean);
+    return (tb - ta) * conductivity * (0.05f + (fast + both) * 0.1f);
+}
+
+void World::UpdateCoarseHeat() {
+    CoarseHeat& coarse = *coarseHeat;
+    const ElementTable& table = elementTable;
+    const ThermalProps* props = GetThermalProps();
 
-                //! 3. Dispersion (Slide down slopes)
-                if (target == -1) {
-                    if (scanX > 0 && grid[belowL] == EMPTY && nextGrid[belowL] == EMPTY) target = belowL;
-                    else if (scanX < width - 1 && grid[belowR] == EMPTY && nextGrid[belowR] == EMPTY) target = belowR;
+    //! 1. Restriction. A chunk's cells only change while it is awake, and every wake-up advances
+    //! its epoch, so the other blocks still hold the averages of their cells.
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        const Chunk& c = chunks[idx];
+        if (coarse.primed && chunkEpochs[idx] <= coarse.epoch && !c.IsAwake() && !c.IsHeatAwake()) continue;
+
+        int left = (idx % chunksX) << CHUNK_SHIFT, top = (idx / chunksX) << CHUNK_SHIFT;
+        int right = std::min(left + CHUNK_SIZE, width), bottom = std::min(top + CHUNK_SIZE, height);
+        float tempSum = 0.0f, condSum = 0.0f;
+        for (int y = top; y < bottom; y++) {
+            layout.ForEachRun(left, y, right - left, [&](int index, int, int length) {
+                for (int k = 0; k < length; k++) {
+                    tempSum += DecodeTemp(gridTemp[index + k]);
+                    condSum += table.conductivity[grid[index + k]];
                 }
-            }
+            });
+        }
+        float cells = (float)((right - left) * (bottom - top));
+        coarse.temp[idx] = tempSum / cells;
+        coarse.cond[idx] = condSum / cells;
+    }
+    coarse.epoch = changeEpoch;
+    coarse.primed = true;
 
-            //! 4. Horizontal Flow (Liquids only)
-            if (state == STATE_LIQUID && target == -1) {
-                int dir = GetRandomValue(0, 1) == 0 ? -1 : 1;
-                int side = i + dir;
-                if (scanX + dir >= 0 && scanX + dir < width && grid[side] == EMPTY && nextGrid[side] == EMPTY) target = side;
+    //! 2. What cell diffusion carries across the right and bottom face of every block. Faces
+    //! between two chunks whose heat is asleep carry nothing: their cells are not diffused.
+    const float fineScale = (float)CoarseHeat::INTERVAL / (CHUNK_SIZE * CHUNK_SIZE);
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        int cx = idx % chunksX, cy = idx / chunksX;
+        int left = cx << CHUNK_SHIFT, top = cy << CHUNK_SHIFT;
+        bool awake = chunks[idx].IsHeatAwake();
 
-                //! Interaction with neighbors (Acid/Water/Lava mixing)
-                int nbs[] = { below, i - 1, i + 1, i - width };
-                for (int n : nbs) ReactionManager::Interact(*this, i, n);
+        float flow = 0.0f;
+        int x = left + CHUNK_SIZE - 1;
+        if (cx + 1 < chunksX && (awake || chunks[idx + 1].IsHeatAwake())) {
+            for (int y = top; y < std::min(top + CHUNK_SIZE, height); y++) {
+                int i = layout.Index(x, y), n = layout.Neighbor(i, x, y, 1, 0);
+                flow += PairFlux(props[grid[i]], props[grid[n]], DecodeTemp(gridTemp[i]), DecodeTemp(gridTemp[n]));
             }
+        }
+        coarse.fineRight[idx] = flow * fineScale;
 
-            //! Apply Movement
-            if (target != -1) {
-                nextGrid[target] = type;
-                nextGrid[i] = EMPTY;
-                //! Move heat with the particle
-                nextGridTemp[target] = nextGridTemp[i];
-                nextGridTemp[i] = AMBIENT_TEMP;
+        flow = 0.0f;
+        int y = top + CHUNK_SIZE - 1;
+        if (cy + 1 < chunksY && (awake || chunks[idx + chunksX].IsHeatAwake())) {
+            for (int x = left; x < std::min(left + CHUNK_SIZE, width); x++) {
+                int i = layout.Index(x, y), n = layout.Neighbor(i, x, y, 0, 1);
+                flow += PairFlux(props[grid[i]], props[grid[n]], DecodeTemp(gridTemp[i]), DecodeTemp(gridTemp[n]));
             }
         }
+        coarse.fineDown[idx] = flow * fineScale;
+    }
+
+    //! 3. Block step
+    coarse.Step(coarseDelta);
+
+    //! 4. Prolongation: cell (x, y) takes pending * its conductivity / the block's mean
+    //! conductivity, so the block takes all of it. What the cells actually took comes
+    //! off 'pending'; the chunk is re-averaged at the next step.
+    for (int idx = 0; idx < (int)chunks.size(); idx++) {
+        float& pending = coarse.pending[idx];
+        pending += coarseDelta[idx];
+        if (std::fabs(pending) < CoarseHeat::EPSILON || coarse.cond[idx] <= 0.0f) continue;
+
+        int left = (idx % chunksX) << CHUNK_SHIFT, top = (idx / chunksX) << CHUNK_SHIFT;
+        int right = std::min(left + CHUNK_SIZE, width), bottom = std::min(top + CHUNK_SIZE, height);
+        //! Block changes are per CHUNK_SIZE^2 cells: edge blocks spread the same heat over fewer
+        const float blockCells = (float)(CHUNK_SIZE * CHUNK_SIZE);
+        float cells = (float)((right - left) * (bottom - top));
+        float scale = pending * (blockCells / cells) / coarse.cond[idx];
+        float applied = 0.0f;
+        int minX = right, minY = bottom, maxX = left - 1, maxY = top - 1;
+        for (int y = top; y < bottom; y++) {
+            layout.ForEachRun(left, y, right - left, [&](int index, int offset, int length) {
+                for (int k = 0; k < length; k++) {
+                    CellTemp old = gridTemp[index + k];
+                    float t = DecodeTemp(old) + scale * table.conductivity[grid[index + k]];
+                    CellTemp next = EncodeTemp(std::min(std::max(t, MIN_TEMP), MAX_TEMP));
+                    if (next == old) continue;
+
+                    gridTemp[index + k] = next;
+                    applied += DecodeTemp(next) - DecodeTemp(old);
+                    int x = left + offset + k;
+                    minX = std::min(minX, x); maxX = std::max(maxX, x);
+                    minY = std::min(minY, y); maxY = y;
+                }
+            });
+        }
+        pending -= applied / blockCells;
+        if (minX <= maxX) MarkDirtyRect(minX, minY, maxX, maxY, WAKE_HEAT);
     }
+}
+
+void World::UpdateParticles() {
+    //! Iterating Bottom-Up for Solids and Liquids
+    for (int y = height - 1; y >= 0; y--) {
+        bool leftToRight = (y % 2 == 0);
+        int cy = y >> CHUNK_SHIFT;
 
-    //! --- PHASE 3: GAS PHYSICS (Top-Down) ---
+        for (int k = 0; k < chunksX; k++) {
+            int cx = leftToRight ? k : (chunksX - 1 - k);
+            const Chunk& chunk = chunks[cy * chunksX + cx];
+
+            //! Sleeping chunks and rows outside the dirty rectangle are skipped
+            if (!chunk.IsAwake() || y < chunk.minY || y > chunk.maxY) continue;
+
+            UpdateParticleRow(chunk, cx, y, leftToRight);
+        }
+    }
+}
+
+void World::UpdateGases() {
+    //! Iterating Top-Down so gases rise
     for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int scanX = (y % 2 == 0) ? x : (width - 1 - x);
-            int i = y * width + scanX;
-            int type = grid[i];
+        bool leftToRight = (y % 2 == 0);
+        int cy = y >> CHUNK_SHIFT;
 
-            if (type == EMPTY || GetElementDef(type).state != STATE_GAS) continue;
+        for (int k = 0; k < chunksX; k++) {
+            int cx = leftToRight ? k : (chunksX - 1 - k);
+            const Chunk& chunk = chunks[cy * chunksX + cx];
 
-            if (y == 0) { nextGrid[i] = EMPTY; continue; } //! Escape at ceiling
+            if (!chunk.IsAwake() || y < chunk.minY || y > chunk.maxY) continue;
+            UpdateGasRow(chunk, cx, y, leftToRight);
+        }
+    }
+}
 
-            int above = i - width;
-            int aboveL = i - width - 1;
-            int aboveR = i - width + 1;
-            int target = -1;
+//! Liquids always run their kernel (they roll for a flow direction). A powder is stuck when the
+//! cell below is taken by anything but a liquid (it could sink into one) and both lower diagonals
+//! are taken too. Diagonals across the chunk edge are not looked up: those powders are visited.
+inline std::uint32_t World::ParticleCandidates(int y, int cx) const {
+    const std::atomic<std::uint32_t>* row = PlaneWords(y, cx);
+    std::uint32_t liquids = row[PLANE_LIQUID].load(std::memory_order_relaxed);
+    if (y + 1 >= height) return liquids;    //! Powders on the floor never move
 
-            if (y > 0) {
-                if (grid[above] == EMPTY && nextGrid[above] == EMPTY) target = above;
-                else if (scanX > 0 && grid[aboveL] == EMPTY && nextGrid[aboveL] == EMPTY) target = aboveL;
-                else if (scanX < width - 1 && grid[aboveR] == EMPTY && nextGrid[aboveR] == EMPTY) target = aboveR;
-            }
+    const std::atomic<std::uint32_t>* below = row + (std::size_t)chunksX * PLANE_COUNT;
+    std::uint32_t liquidsBelow = below[PLANE_LIQUID].load(std::memory_order_relaxed);
+    std::uint32_t taken = below[PLANE_STATIC].load(std::memory_order_relaxed) | below[PLANE_POWDER].load(std::memory_order_relaxed) |
+                          liquidsBelow | below[PLANE_GAS].load(std::memory_order_relaxed);
+    std::uint32_t stuck = taken & ~liquidsBelow & (taken << 1) & (taken >> 1);
+    return (row[PLANE_POWDER].load(std::memory_order_relaxed) & ~stuck) | liquids;
+}
 
-            //! Ceiling spread behavior
-            if (target == -1) {
-                int dir = GetRandomValue(0, 1) == 0 ? -1 : 1;
-                int side = i + dir;
-                if (scanX + dir >= 0 && scanX + dir < width && grid[side] == EMPTY && nextGrid[side] == EMPTY) target = side;
-            }
+void World::UpdateParticleRow(const Chunk& chunk, int cx, int y, bool leftToRight) {
+    int left = cx << CHUNK_SHIFT;
 
-            //! Fire specific behavior (Burning wood)
-            if (type == FIRE) {
-                int fireNbs[] = { i - 1, i + 1, i - width, i + width };
-                for (int n : fireNbs) if (IsValid(n) && grid[n] == WOOD && GetRandomValue(0, 20) == 0) {
-                    nextGrid[n] = FIRE; nextGridTemp[n] = 1200.0f;
-                }
+    //! As in UpdateGasRow. Moves only fill cells of this row and the one below, which never frees a
+    //! stuck powder, so candidates are re-derived only after a reaction (it may empty a cell below).
+    //! Bits left behind by cells that moved on are harmless: those cells are empty or already moved.
+    std::uint32_t pending = (~0u >> (CHUNK_SIZE - 1 - (chunk.maxX - left))) & (~0u << (chunk.minX - left));
+    std::uint32_t bits = ParticleCandidates(y, cx) & pending;
+    if (!bits) return;
 
-                //? Need Smoke or not?
-                ////! Fire dies out
-                //if (GetRandomValue(0, 100) < 2) {
-                //    nextGrid[i] = SMOKE;
-                //    target = -1;
-                //}
-            }
-            //! Smoke decay
-            if (type == SMOKE && GetRandomValue(0, 1000) == 0) {
-                nextGrid[i] = EMPTY;
-                target = -1;
+    //! Same random stream as a full scan of the row: skipped cells draw no numbers
+    Random::SetStream(seed, tick, RNG_PARTICLES, y * chunksX + cx);
+    do {
+        int bit = leftToRight ? LowestBit(bits) : HighestBit(bits);
+        pending &= leftToRight ? (~0u << bit) << 1 : (1u << bit) - 1;
+        int reactions = threadCounters.reactions;
+        UpdateParticleCell(left + bit, y);
+        bits &= pending;
+        if (threadCounters.reactions != reactions) bits = ParticleCandidates(y, cx) & pending;
+    } while (bits);
+}
+
+void World::UpdateGasRow(const Chunk& chunk, int cx, int y, bool leftToRight) {
+    int left = cx << CHUNK_SHIFT;
+    const std::atomic<std::uint32_t>& live = PlaneWords(y, cx)[PLANE_GAS];
+
+    //! Cells of the rectangle not visited yet. The mask is re-read after every cell: a gas
+    //! spreading sideways sets a bit ahead of the scan (skipped anyway, it already moved).
+    std::uint32_t pending = (~0u >> (CHUNK_SIZE - 1 - (chunk.maxX - left))) & (~0u << (chunk.minX - left));
+    std::uint32_t bits = live.load(std::memory_order_relaxed) & pending;
+    if (!bits) return;
+
+    //! Same random stream as a full scan of the row: cells without a gas kernel draw no numbers
+    Random::SetStream(seed, tick, RNG_GASES, y * chunksX + cx);
+    do {
+        int bit = leftToRight ? LowestBit(bits) : HighestBit(bits);
+        pending &= leftToRight ? (~0u << bit) << 1 : (1u << bit) - 1;
+        UpdateGasCell(left + bit, y);
+        bits = live.load(std::memory_order_relaxed) & pending;
+    } while (bits);
+}
+
+//! Chunks of one checkerboard color are at least one chunk apart. Cells only read and
+//! write neighbors one cell away, so those chunks can be updated concurrently.
+void World::UpdateParticlesParallel() {
+    for (int phase = 0; phase < 4; phase++) {
+        const std::vector<int>& list = phaseChunks[phase];
+
+        pool->ParallelFor((int)list.size(), [&](int k) {
+            const Chunk& chunk = chunks[list[k]];
+            int cx = list[k] % chunksX;
+
+            //! Same scan order and random streams as the serial path, restricted to the chunk
+            for (int y = chunk.maxY; y >= chunk.minY; y--) UpdateParticleRow(chunk, cx, y, y % 2 == 0);
+            FlushCounters();
+        });
+    }
+}
+
+void World::UpdateGasesParallel() {
+    for (int phase = 0; phase < 4; phase++) {
+        const std::vector<int>& list = phaseChunks[phase];
+
+        pool->ParallelFor((int)list.size(), [&](int k) {
+            const Chunk& chunk = chunks[list[k]];
+            int cx = list[k] % chunksX;
+
+            for (int y = chunk.minY; y <= chunk.maxY; y++) UpdateGasRow(chunk, cx, y, y % 2 == 0);
+            FlushCounters();
+        });
+    }
+}
+
+void World::BuildKernelTables() {
+    const ElementTable& table = elementTable;
+
+    for (int id = 0; id < ELEMENT_COUNT; id++) {
+        //! Heat tools: air takes nothing, dense matter resists
+        switch (table.state[id]) {
+            case STATE_POWDER: heatToolScale[id] = 1.0f / 5.0f; break;
+            case STATE_LIQUID: heatToolScale[id] = 1.0f / 5.0f; break;
+            case STATE_STATIC: heatToolScale[id] = 1.0f / 10.0f; break;
+            default: heatToolScale[id] = 1.0f; break;
+        }
+        if (id == EMPTY) heatToolScale[id] = 0.0f;
+
+        particleKernels[id] = KERNEL_NONE;
+        gasKernels[id] = KERNEL_NONE;
+        planeBits[id] = 0;
+        if (id == EMPTY) continue;
+        if (id == WALL) { planeBits[id] = 1u << PLANE_STATIC; continue; }
+
+        switch (table.state[id]) {
+            case STATE_POWDER: particleKernels[id] = KERNEL_POWDER; break;
+            case STATE_LIQUID: particleKernels[id] = KERNEL_LIQUID; break;
+            case STATE_GAS: gasKernels[id] = id == FIRE ? KERNEL_FIRE : id == SMOKE ? KERNEL_SMOKE : KERNEL_GAS; break;
+            default: break; //! Statics never move
+        }
+        if (particleKernels[id] == KERNEL_POWDER) planeBits[id] = 1u << PLANE_POWDER;
+        else if (particleKernels[id] == KERNEL_LIQUID) planeBits[id] = 1u << PLANE_LIQUID;
+        else if (gasKernels[id] != KERNEL_NONE) planeBits[id] = 1u << PLANE_GAS;
+        else planeBits[id] = 1u << PLANE_STATIC;
+    }
+}
+
+//! The switches compile to jump tables; each case is its own inlined specialization
+inline void World::UpdateParticleCell(int x, int y) {
+    switch (particleKernels[grid[layout.Index(x, y)]]) {
+        case KERNEL_POWDER: ParticleKernel<KERNEL_POWDER>(x, y); break;
+        case KERNEL_LIQUID: ParticleKernel<KERNEL_LIQUID>(x, y); break;
+        default: break;
+    }
+}
+
+inline void World::UpdateGasCell(int x, int y) {
+    switch (gasKernels[grid[layout.Index(x, y)]]) {
+        case KERNEL_GAS: GasKernel<KERNEL_GAS>(x, y); break;
+        case KERNEL_FIRE: GasKernel<KERNEL_FIRE>(x, y); break;
+        case KERNEL_SMOKE: GasKernel<KERNEL_SMOKE>(x, y); break;
+        default: break;
+    }
+}
+
+template <int Kernel>
+void World::ParticleKernel(int x, int y) {
+    static_assert(Kernel == KERNEL_POWDER || Kernel == KERNEL_LIQUID, "Phase 2 moves powders and liquids");
+    const ElementTable& table = elementTable;
+
+    int i = layout.Index(x, y);
+    int type = grid[i];
+
+    //! Already moved this phase (fell or flowed into this cell, or was displaced by a powder)
+    if (moved[i] == moveStamp) return;
+
+    //! Calculate neighbor indices (only read once their coordinates are checked)
+    int below = layout.Neighbor(i, x, y, 0, 1);
+    int belowL = layout.Neighbor(i, x, y, -1, 1);
+    int belowR = layout.Neighbor(i, x, y, 1, 1);
+
+    int target = -1;
+    int targetX = x, targetY = y + 1; //! Coordinates of 'target' (spares a division per move)
+
+    if (y < height - 1) {
+        //! 1. Gravity (Fall down)
+        if (IsFree(below)) target = below;
+
+        //! 2. Density Check (Sinking in liquids)
+        else if constexpr (Kernel == KERNEL_POWDER) {
+            int belowType = grid[below];
+            if (table.state[belowType] == STATE_LIQUID && moved[below] != moveStamp) {
+                //! Swap particle and liquid
+                grid[below] = type; grid[i] = belowType;
+                TogglePlane(x, y, PLANE_POWDER); TogglePlane(x, y, PLANE_LIQUID);
+                TogglePlane(x, y + 1, PLANE_POWDER); TogglePlane(x, y + 1, PLANE_LIQUID);
+                //! Swap temperature
+                std::swap(gridTemp[below], gridTemp[i]);
+                moved[below] = moved[i] = moveStamp;
+                threadCounters.cellsMoved++;
+                WakeFlags wake = MoveWake(x, y, x, y + 1);
+                MarkDirty(x, y, wake); MarkDirty(x, y + 1, wake);
+                return; //! Move handled, skip to next
             }
+        }
 
-            //! Apply Movement
-            if (target != -1) {
-                nextGrid[target] = type;
-                nextGrid[i] = EMPTY;
-                nextGridTemp[target] = nextGridTemp[i];
-                nextGridTemp[i] = AMBIENT_TEMP;
+        //! 3. Dispersion (Slide down slopes)
+        if (target == -1) {
+            if (x > 0 && IsFree(belowL)) { target = belowL; targetX = x - 1; }
+            else if (x < width - 1 && IsFree(belowR)) { target = belowR; targetX = x + 1; }
+        }
+    }
+
+    //! 4. Horizontal Flow (Liquids only)
+    if (Kernel == KERNEL_LIQUID && target == -1) {
+        int left = layout.Neighbor(i, x, y, -1, 0);
+        int right = layout.Neighbor(i, x, y, 1, 0);
+        int dir = Random::Bool() ? -1 : 1;
+        int side = dir < 0 ? left : right;
+        if (x + dir >= 0 && x + dir < width && IsFree(side)) { target = side; targetX = x + dir; targetY = y; }
+
+        //! Blocked this time, but an open side means it may flow next tick
+        if (target == -1 && ((x > 0 && grid[left] == EMPTY) || (x < width - 1 && grid[right] == EMPTY))) {
+            MarkDirty(x, y, WAKE_MOTION);
+        }
+
+        //! Interaction with neighbors (Acid/Water/Lava mixing); inert liquids skip the checks
+        std::uint32_t reactsWith = reactionTable.reactsWith[type];
+        if (reactsWith != 0) {
+            //! Left/right neighbors do not wrap across rows (chunk updates rely on locality)
+            int nbs[] = { y < height - 1 ? below : -1, x > 0 ? left : -1, x < width - 1 ? right : -1, y > 0 ? layout.Neighbor(i, x, y, 0, -1) : -1 };
+            for (int n : nbs) {
+                if (!IsValid(n) || !((reactsWith >> grid[n]) & 1u)) continue;
+
+                //! A reaction that failed its roll keeps the cell awake
+                if (!ReactionManager::Interact(*this, i, n)) { MarkDirty(x, y, WAKE_MOTION); continue; }
+
+                threadCounters.reactions++;
+
+                //! Converted or consumed: the new element has its own rules (next tick)
+                if (grid[i] != type) break;
             }
         }
+
+        //! A reaction may have consumed or converted this cell
+        if (target != -1 && grid[i] != type) target = -1;
+    }
+
+    //! Apply Movement (into air: the particle's planes move with it)
+    if (target != -1) {
+        grid[target] = type;
+        grid[i] = EMPTY;
+        const Plane plane = Kernel == KERNEL_POWDER ? PLANE_POWDER : PLANE_LIQUID;
+        TogglePlane(targetX, targetY, plane); TogglePlane(x, y, plane);
+        //! Move heat with the particle
+        gridTemp[target] = gridTemp[i];
+        gridTemp[i] = AMBIENT_CELL_TEMP;
+        moved[target] = moved[i] = moveStamp;
+        threadCounters.cellsMoved++;
+
+        WakeFlags wake = MoveWake(x, y, targetX, targetY);
+        MarkDirty(x, y, wake);
+        MarkDirty(targetX, targetY, wake);
     }
+}
+
+template <int Kernel>
+void World::GasKernel(int x, int y) {
+    static_assert(Kernel == KERNEL_GAS || Kernel == KERNEL_FIRE || Kernel == KERNEL_SMOKE, "Phase 3 moves gases");
+
+    int i = layout.Index(x, y);
+    int type = grid[i];
 
-    grid = nextGrid;
-    gridTemp = nextGridTemp;
-}
\ No newline at end of file
+    //! Already rose or spread this phase
+    if (moved[i] == moveStamp) return;
+
+    //! Gases are never at rest (random spread, decay, burning); flames are also heat sources
+    MarkDirty(x, y, Kernel == KERNEL_FIRE ? WAKE_ALL : WAKE_MOTION);
+
+    //! Escape at the world's ceiling (the air left behind keeps the gas's heat); below frozen
+    //! pages of a streamed world the top row is a ceiling only until the window moves
+    if (y == 0 && !(openEdges & EDGE_TOP)) { grid[i] = EMPTY; moved[i] = moveStamp; TogglePlane(x, y, PLANE_GAS); MarkDirty(x, y, MoveWake(x, y, x, y)); return; }
+
+    int above = layout.Neighbor(i, x, y, 0, -1);
+    int aboveL = layout.Neighbor(i, x, y, -1, -1);
+    int aboveR = layout.Neighbor(i, x, y, 1, -1);
+    int target = -1;
+    int targetX = x, targetY = y - 1; //! Coordinates of 'target' (spares a division per move)
+
+    if (y > 0) {
+        if (IsFree(above)) target = above;
+        else if (x > 0 && IsFree(aboveL)) { target = aboveL; targetX = x - 1; }
+        else if (x < width - 1 && IsFree(aboveR)) { target = aboveR; targetX = x + 1; }
+    }
+
+    //! Ceiling spread behavior
+    if (target == -1) {
+        int dir = Random::Bool() ? -1 : 1;
+        int side = layout.Neighbor(i, x, y, dir, 0);
+        if (x + dir >= 0 && x + dir < width && IsFree(side)) { target = side; targetX = x + dir; targetY = y; }
+    }
+
+    //! Fire specific behavior (Burning wood)
+    if constexpr (Kernel == KERNEL_FIRE) {
+        int fireNbs[] = { x > 0 ? layout.Neighbor(i, x, y, -1, 0) : -1, x < width - 1 ? layout.Neighbor(i, x, y, 1, 0) : -1,
+                          layout.Neighbor(i, x, y, 0, -1), y < height - 1 ? layout.Neighbor(i, x, y, 0, 1) : -1 };
+        for (int n : fireNbs) if (IsValid(n) && grid[n] == WOOD && Random::OneIn(21)) {
+            grid[n] = FIRE; TogglePlanes(n, (1u << PLANE_STATIC) | (1u << PLANE_GAS));
+            gridTemp[n] = EncodeTemp(1200.0f);
+            moved[n] = moveStamp; //! New flames start moving next tick
+            threadCounters.reactions++;
+            MarkDirty(n);
+        }
+
+        //? Need Smoke or not?
+        ////! Fire dies out
+        //if (Random::Range(0, 100) < 2) {
+        //    grid[i] = SMOKE;
+        //    target = -1;
+        //}
+    }
+    //! Smoke decay
+    if (Kernel == KERNEL_SMOKE && Random::OneIn(1001)) {
+        grid[i] = EMPTY;
+        moved[i] = moveStamp;
+        TogglePlane(x, y, PLANE_GAS);
+        MarkDirty(x, y, MoveWake(x, y, x, y));
+        target = -1;
+    }
+
+    //! Apply Movement
+    if (target != -1) {
+        grid[target] = type;
+        grid[i] = EMPTY;
+        TogglePlane(targetX, targetY, PLANE_GAS); TogglePlane(x, y, PLANE_GAS);
+        gridTemp[target] = gridTemp[i];
+        gridTemp[i] = AMBIENT_CELL_TEMP;
+        moved[target] = moved[i] = moveStamp;
+        threadCounters.cellsMoved++;
+        WakeFlags wake = MoveWake(x, y, targetX, targetY);
+        MarkDirty(x, y, wake);
+        MarkDirty(targetX, targetY, wake);
+    }
+}
@@ -1,22 +1,304 @@
 #pragma once
+#include <atomic>
+#include <memory>
 #include <vector>
+#include "CellFormat.h"
+#include "Elements.h"
+#include "GridLayout.h"
+#include "GridView.h"
+
+class ThreadPool;
+struct ThermalTile;
+class CoarseHeat;
+
+//! Wall-clock cost of each phase of the last World::Update() (milliseconds)
+struct TickTimings {
+    double thermo = 0.0;  //! Phase 1: Thermodynamics & phase change
+    double solids = 0.0;  //! Phase 2: Powders & liquids
+    double gases = 0.0;   //! Phase 3: Gases
+};
+
+//! Work done by the last World::Update()
+struct TickCounters {
+    int cellsMoved = 0;     //! Cells that fell, flowed, sank or rose
+    int reactions = 0;      //! Chemical reactions and fire spreading to wood
+    int phaseChanges = 0;   //! Melting, freezing, boiling and combustion
+    int activeCells = 0;    //! Cells inside awake dirty rectangles
+    int heatCells = 0;      //! Cells inside awake heat rectangles (diffused by phase 1)
+};
+
+//! Lock-free min/max used to grow dirty rectangles
+inline void AtomicMin(std::atomic<int>& a, int v) {
+    int cur = a.load(std::memory_order_relaxed);
+    while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+inline void AtomicMax(std::atomic<int>& a, int v) {
+    int cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+//! Schedules reached by a wake-up: particle movement (phases 2-3), heat diffusion (phase 1) or both
+enum WakeFlags {
+    WAKE_MOTION = 1,
+    WAKE_HEAT = 2,
+    WAKE_ALL = WAKE_MOTION | WAKE_HEAT
+};
+
+//! Fixed-size square region of the grid with its own dirty rectangles.
+//! Movement and heat are scheduled separately: settled temperatures skip diffusion while
+//! particles move, and cooling regions do not keep the movement phases busy.
+//! A chunk whose rectangles are both empty is asleep and skipped by every phase.
+struct Chunk {
+    //! Cells processed by the movement phases this tick (inclusive bounds, empty when minX > maxX)
+    int minX, minY, maxX, maxY;
+
+    //! Cells diffused by the heat phase this tick (same convention)
+    int heatMinX, heatMinY, heatMaxX, heatMaxY;
+
+    //! Cells touched during this tick, processed on the next one.
+    //! Atomic because neighboring chunks may mark them from worker threads.
+    std::atomic<int> nextMinX, nextMinY, nextMaxX, nextMaxY;
+    std::atomic<int> nextHeatMinX, nextHeatMinY, nextHeatMaxX, nextHeatMaxY;
+
+    //! False only while every cell of the chunk is at ambient temperature: set by any heat
+    //! wake-up, cleared by a scan when the heat rectangle falls asleep
+    std::atomic<bool> warm;
+
+    bool IsAwake() const { return minX <= maxX; }
+    bool IsHeatAwake() const { return heatMinX <= heatMaxX; }
+
+    //! Grows the next rectangles of the schedules in 'wake' (WakeFlags) by a cell rectangle
+    void Wake(int x0, int y0, int x1, int y1, WakeFlags wake) {
+        if (wake & WAKE_MOTION) {
+            AtomicMin(nextMinX, x0); AtomicMax(nextMaxX, x1);
+            AtomicMin(nextMinY, y0); AtomicMax(nextMaxY, y1);
+        }
+        if (wake & WAKE_HEAT) {
+            AtomicMin(nextHeatMinX, x0); AtomicMax(nextHeatMaxX, x1);
+            AtomicMin(nextHeatMinY, y0); AtomicMax(nextHeatMaxY, y1);
+            if (!warm.load(std::memory_order_relaxed)) warm.store(true, std::memory_order_relaxed);
+        }
+    }
+};
+
+//! Movement behavior of an element; each one is compiled into its own kernel specialization
+enum CellKernel {
+    KERNEL_POWDER = 0,  //! Falls, slides down slopes, sinks through liquids
+    KERNEL_LIQUID = 1,  //! Falls, flows sideways, reacts with neighbors
+    KERNEL_GAS = 2,     //! Rises and spreads under ceilings
+    KERNEL_FIRE = 3,    //! Gas that ignites neighboring wood
+    KERNEL_SMOKE = 4,   //! Gas that slowly decays
+    KERNEL_NONE = 255   //! Does not move (air, statics)
+};
 
 class World {
+public:
+    //! Chunk edge length in cells (power of two)
+    static const int CHUNK_SHIFT = 5;
+    static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+
 private:
-    //! Double buffering for particle data
-    std::vector<int> grid;
-    std::vector<int> nextGrid;
+    //! Particle data (element IDs), updated in place
+    std::vector<CellType> grid;
 
-    //! Double buffering for temperature data (Thermodynamics)
-    std::vector<float> gridTemp;
-    std::vector<float> nextGridTemp;
+    //! Temperature data (Thermodynamics), updated in place; see CellFormat.h for the encoding
+    std::vector<CellTemp> gridTemp;
+
+    //! Heat stencil output; only the awake rectangles are written and copied back
+    std::vector<CellTemp> thermalScratch;
+
+    //! Per-cell flag byte: cells that already moved during the current phase, and cells vacated
+    //! during it, hold the phase's stamp. Stamps advance every phase, so the array only needs
+    //! clearing when they wrap.
+    std::vector<std::uint8_t> moved;
+    std::uint8_t moveStamp = 0;
+
+    //! Movement target test: empty since the start of the phase. A cell vacated during a sweep
+    //! opens up next tick (as with the old double-buffered update), so falling columns spread
+    //! out into gaps instead of dropping as a solid block.
+    bool IsFree(int index) const { return grid[index] == EMPTY && moved[index] != moveStamp; }
 
     int width;
     int height;
 
+    //! Cell (x, y) of every per-cell array lives at layout.Index(x, y)
+    GridLayout layout;
+
+    //! Sleeping / dirty-rect scheduling
+    std::vector<Chunk> chunks;
+    int chunksX;
+    int chunksY;
+    int activeCells = 0;
+    int heatCells = 0;
+
+    //! Parallel mode (null = serial row scan)
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<int> phaseChunks[4]; //! Awake chunks of each checkerboard color
+
+    //! Scratch working set of the heat stencil
+    std::unique_ptr<ThermalTile> thermalTile;
+    std::vector<int> unstableCells; //! Cells past a phase-change threshold this tick
+
+    //! Hierarchical thermal mode (null = cell diffusion only)
+    std::unique_ptr<CoarseHeat> coarseHeat;
+    std::vector<float> coarseDelta;
+
+    //! Change tracking for renderers: a chunk's epoch is the change epoch of the last Update()
+    //! (or Reset()) that could have modified it
+    std::vector<std::uint32_t> chunkEpochs;
+    std::uint32_t changeEpoch = 0;
+
+    //! Deterministic replay: random streams are keyed by (seed, tick, phase, work unit)
+    std::uint32_t seed = 0;
+    std::uint32_t tick = 0;
+
+    //! Position of this grid inside a larger streamed world (see WorldPager)
+    int originX = 0;
+    int originY = 0;
+    int openEdges = 0;  //! EDGE_* bits
+
+    TickTimings lastTimings;
+
+    //! Counters of the running tick (worker threads tally locally, then merge here)
+    std::atomic<int> movedTally{ 0 };
+    std::atomic<int> reactionTally{ 0 };
+    std::atomic<int> phaseChangeTally{ 0 };
+    TickCounters lastCounters;
+    void FlushCounters();
+
+    //! Wakes a cell rectangle (inclusive) plus a one-cell border for the next tick
+    void MarkDirtyRect(int minX, int minY, int maxX, int maxY, WakeFlags wake = WAKE_ALL);
+
+    //! Wakes the cell at (x, y) and its 8 neighbors for the next tick
+    void MarkDirty(int x, int y, WakeFlags wake = WAKE_ALL) {
+        //! Fast path: the 3x3 block lies inside a single chunk
+        int lx = (x & (CHUNK_SIZE - 1)) - 1;
+        int ly = (y & (CHUNK_SIZE - 1)) - 1;
+        if ((unsigned int)lx < CHUNK_SIZE - 2 && (unsigned int)ly < CHUNK_SIZE - 2 && x + 1 < width && y + 1 < height) {
+            chunks[(y >> CHUNK_SHIFT) * chunksX + (x >> CHUNK_SHIFT)].Wake(x - 1, y - 1, x + 1, y + 1, wake);
+            return;
+        }
+        MarkDirtyRect(x, y, x, y, wake);
+    }
+    void MarkDirty(int index, WakeFlags wake = WAKE_ALL) { MarkDirty(layout.X(index), layout.Y(index), wake); }
+
+    //! True when every cell of the rectangle (inclusive, clamped to the world) is at ambient temperature
+    bool IsAmbientRect(int minX, int minY, int maxX, int maxY) const;
+
+    //! Schedules to wake at both ends of a move from (x0, y0) to (x1, y1): the heat phase only when
+    //! something around them is warm, since moves through ambient cells exchange no heat
+    WakeFlags MoveWake(int x0, int y0, int x1, int y1) const;
+
+    //! Promotes the collected rectangles to this tick's work set
+    void BeginTick();
+
+    //! Starts a movement phase: forgets which cells moved in the previous one
+    void NextMoveStamp();
+
+    //! Update phases (each visits awake chunks only)
+    void UpdateThermodynamics();
+    void UpdateParticles();
+
+    //! Phase 1, every CoarseHeat::INTERVAL ticks: restricts changed chunks to their blocks,
+    //! steps the block level and spreads its changes back over the cells
+    void UpdateCoarseHeat();
+    void UpdateGases();
+
+    //! Parallel variants: 4-color checkerboard of chunks on the thread pool
+    void UpdateParticlesParallel();
+    void UpdateGasesParallel();
+
+    //! Per-element kernel of each movement phase (KERNEL_NONE = the element does not move in it)
+    std::uint8_t particleKernels[ELEMENT_COUNT];
+    std::uint8_t gasKernels[ELEMENT_COUNT];
+    void BuildKernelTables();
+
+    //! Share of a heat tool's change each element takes (1 / thermal resistance, 0 = untouched)
+    float heatToolScale[ELEMENT_COUNT];
+
+    //! Occupancy bitplanes, one per class of cell: PLANE_COUNT interleaved words per row of each
+    //! chunk column, bit k = cell (cx * CHUNK_SIZE + k, y). A cell is in at most one plane (EMPTY in
+    //! none), so a move flips one bit at each end and occupancy is the union of the planes.
+    //! Phase 2 finds the powders and liquids that can move 32 cells at a time, phase 3 visits only
+    //! the gases, so both follow the moving matter rather than the awake area.
+    //! Atomic because cells near a chunk edge flip bits of the neighboring chunk's words.
+    enum Plane {
+        PLANE_STATIC = 0,       //! Walls, wood, stone, ice
+        PLANE_POWDER,           //! Powder kernel
+        PLANE_LIQUID,           //! Liquid kernel
+        PLANE_GAS,              //! Gas kernel (smoke, steam, fire)
+        PLANE_COUNT
+    };
+    std::unique_ptr<std::atomic<std::uint32_t>[]> planes;
+
+    //! Plane each element belongs to (bit p = Plane p; 0 for EMPTY)
+    std::uint8_t planeBits[ELEMENT_COUNT];
+
+    std::atomic<std::uint32_t>* PlaneWords(int y, int cx) { return &planes[((std::size_t)y * chunksX + cx) * PLANE_COUNT]; }
+    const std::atomic<std::uint32_t>* PlaneWords(int y, int cx) const { return &planes[((std::size_t)y * chunksX + cx) * PLANE_COUNT]; }
+
+    //! Flips the bit of (x, y) in 'plane'; callers flip the planes a cell enters and leaves
+    void TogglePlane(int x, int y, Plane plane) {
+        std::atomic<std::uint32_t>& word = PlaneWords(y, x >> CHUNK_SHIFT)[plane];
+        std::uint32_t bit = 1u << (x & (CHUNK_SIZE - 1));
+        //! A locked read-modify-write is only needed while chunks update concurrently
+        if (pool) word.fetch_xor(bit, std::memory_order_relaxed);
+        else word.store(word.load(std::memory_order_relaxed) ^ bit, std::memory_order_relaxed);
+    }
+
+    //! Flips (x, y) in every plane of 'mask' (bit p = Plane p)
+    void TogglePlanes(int index, unsigned int mask) {
+        int x = layout.X(index), y = layout.Y(index);
+        for (int p = 0; p < PLANE_COUNT; p++) {
+            if ((mask >> p) & 1u) TogglePlane(x, y, (Plane)p);
+        }
+    }
+    bool IsGasKernel(int type) const { return gasKernels[type] != KERNEL_NONE; }
+
+    //! Stores an element and keeps the planes in sync
+    void WriteCell(int index, int type) {
+        unsigned int flip = planeBits[grid[index]] ^ planeBits[type];
+        grid[index] = (CellType)type;
+        if (flip) TogglePlanes(index, flip);
+    }
+
+    //! Recomputes the planes from the grid (after bulk writes)
+    void RebuildPlanes();
+
+    //! Powders and liquids of a chunk row that may move (see UpdateParticleRow)
+    std::uint32_t ParticleCandidates(int y, int cx) const;
+
+    //! Batched edits: one row span [x0, x1] of row y (already clipped); callers wake the bounding box
+    void FillSpan(int y, int x0, int x1, int type);
+    void HeatSpan(int y, int x0, int x1, float delta);
+
+    //! Calls spanOp(y, x0, x1) for every row of the capsule of 'radius' around the segment
+    //! (x0, y0)-(x1, y1), clipped to the world, then wakes its bounding box
+    template <typename SpanOp> void ForEachStrokeSpan(int x0, int y0, int x1, int y1, int radius, WakeFlags wake, SpanOp spanOp);
+
+    //! Phase 2 for one row of a chunk: visits the powders and liquids of the dirty rectangle that may
+    //! move, in scan order
+    void UpdateParticleRow(const Chunk& chunk, int cx, int y, bool leftToRight);
+
+    //! Phase 3 for one row of a chunk: visits the live gas cells of the dirty rectangle in scan order
+    void UpdateGasRow(const Chunk& chunk, int cx, int y, bool leftToRight);
+
+    //! Movement rules, specialized per CellKernel so no cell pays for another class's behavior
+    template <int Kernel> void ParticleKernel(int x, int y);
+    template <int Kernel> void GasKernel(int x, int y);
+
+    //! Per-cell entry points shared by the serial and parallel paths: one table lookup per cell
+    void UpdateParticleCell(int x, int y);
+    void UpdateGasCell(int x, int y);
+
 public:
     //! Constructor: Initializes grids
     World(int w, int h);
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
 
     //! Main update loop: Physics + Thermodynamics
     void Update();
@@ -24,6 +306,10 @@ public:
     //! Clears the world and resets temperature
     void Reset();
 
+    //! Array index of cell (x, y); every index below is one (see GridLayout)
+    int Index(int x, int y) const { return layout.Index(x, y); }
+    const GridLayout& GetLayout() const { return layout; }
+
     //! Boundary check
     bool IsValid(int index) const;
 
@@ -35,10 +321,120 @@ public:
     float GetTemp(int index) const;
     void SetTemp(int index, float temp);
 
-    //! Data access for Renderer (Const references for performance)
-    const std::vector<int>& GetGridData() const { return grid; }
-    const std::vector<float>& GetTempData() const { return gridTemp; }
+    //! --- Batched edits ---
+    //! Work on whole row spans: clipping, element lookups and scheduling happen once per edit,
+    //! not once per cell. Tool IDs are ignored; WALL cells are only replaced by WALL or EMPTY.
+
+    //! Fills the rectangle (inclusive) with 'type' at the element's base temperature
+    void FillRect(int minX, int minY, int maxX, int maxY, int type);
+
+    //! Fills every cell within 'radius' of (cx, cy)
+    void FillCircle(int cx, int cy, int radius, int type);
+
+    //! Fills every cell within 'radius' of the segment (x0, y0)-(x1, y1): a brush dragged
+    //! between two frames leaves no gaps
+    void PaintStroke(int x0, int y0, int x1, int y1, int radius, int type);
+
+    //! Heats (delta > 0) or cools every non-empty cell within 'radius' of (cx, cy). Each element
+    //! takes delta / its thermal resistance (powders and liquids 5, statics 10, gases 1)
+    void ApplyHeatRegion(int cx, int cy, int radius, float delta);
+
+    //! Data access for Renderer (Const references for performance; decode temperatures with DecodeTemp).
+    //! Cells are stored in GetLayout() order.
+    const std::vector<CellType>& GetGridData() const { return grid; }
+    const std::vector<CellTemp>& GetTempData() const { return gridTemp; }
+
+    //! Everything a renderer reads, as one read-only view (valid until the World changes)
+    GridView GetView() const {
+        GridView v;
+        v.cells = grid.data();
+        v.temps = gridTemp.data();
+        v.width = width;
+        v.height = height;
+        v.layout = layout;
+        v.chunkEpochs = chunkEpochs.data();
+        v.chunksX = chunksX;
+        v.changeEpoch = changeEpoch;
+        v.tick = tick;
+        v.originX = originX;
+        v.originY = originY;
+        return v;
+    }
+
+    //! Writable cell buffers for bulk restores (Snapshot); call Restore() once they are filled
+    CellType* GetGridBuffer() { return grid.data(); }
+    CellTemp* GetTempBuffer() { return gridTemp.data(); }
+
+    //! Continues from externally written buffers at (seed, tick); every chunk is redrawn.
+    //! 'pending' (PENDING_INTS per chunk, see GetPendingRects) restores which
+    //! cells the next Update() processes, for a bit-exact resume; nullptr wakes every chunk.
+    //! 'coarsePending' (one per chunk, see GetCoarsePending) restores the block changes of the
+    //! coarse heat mode not yet handed to the cells; nullptr drops them.
+    void Restore(std::uint32_t seed, std::uint32_t tick, const std::int32_t* pending = nullptr, const float* coarsePending = nullptr);
+
+    //! Ints per chunk in the pending rects: the movement rectangle, then the heat rectangle
+    static const int PENDING_INTS = 8;
+
+    //! Cells the next Update() will process: PENDING_INTS per chunk (minX, minY, maxX, maxY of the
+    //! movement and heat rectangles; minX > maxX when asleep)
+    void GetPendingRects(std::vector<std::int32_t>& rects) const;
+
+    //! Block changes of the coarse heat mode not yet handed to the cells, one per chunk
+    //! (empty when the mode is off)
+    void GetCoarsePending(std::vector<float>& values) const;
+
+    //! Bytes of grid state per cell (ID + temperature + flags)
+    static constexpr int BYTES_PER_CELL = sizeof(CellType) + sizeof(CellTemp) + sizeof(std::uint8_t);
 
     int GetWidth() const { return width; }
     int GetHeight() const { return height; }
-};
\ No newline at end of file
+
+    //! Chunk access (debug views, statistics)
+    const std::vector<Chunk>& GetChunks() const { return chunks; }
+    int GetChunksX() const { return chunksX; }
+    int GetChunksY() const { return chunksY; }
+
+    //! Random seed of the simulation; the same seed and edits replay bit for bit
+    void SetSeed(std::uint32_t s) { seed = s; }
+    std::uint32_t GetSeed() const { return seed; }
+
+    //! Number of Update() calls since construction or the last Reset()
+    std::uint32_t GetTick() const { return tick; }
+
+    //! Where cell (0, 0) lies in a streamed world; set by WorldPager when it moves the window
+    void SetOrigin(int x, int y) { originX = x; originY = y; }
+    int GetOriginX() const { return originX; }
+    int GetOriginY() const { return originY; }
+
+    //! Grid edges that continue into frozen pages of a streamed world (set by WorldPager).
+    //! Cells treat every edge as blocked, but an open edge is only blocked for now: gas escapes
+    //! through the top edge only where it is the top of the whole world.
+    enum Edge { EDGE_LEFT = 1, EDGE_TOP = 2, EDGE_RIGHT = 4, EDGE_BOTTOM = 8 };
+    void SetOpenEdges(int edges) { openEdges = edges; }
+    int GetOpenEdges() const { return openEdges; }
+
+    //! Change epochs: cells of chunk c may differ from what was drawn at epoch E if chunkEpochs[c] > E
+    const std::vector<std::uint32_t>& GetChunkEpochs() const { return chunkEpochs; }
+    std::uint32_t GetChangeEpoch() const { return changeEpoch; }
+
+    //! Hierarchical thermal mode: long-range heat flow through a coarse grid of chunk
+    //! averages on top of cell diffusion (see CoarseHeat). Off by default.
+    void SetCoarseHeat(bool enabled);
+    bool IsCoarseHeat() const { return coarseHeat != nullptr; }
+
+    //! Threads used by the particle phases (1 = serial row scan, the default)
+    void SetThreadCount(int threads);
+    int GetThreadCount() const;
+
+    //! Number of cells inside awake dirty rectangles during the last Update()
+    int GetActiveCellCount() const { return activeCells; }
+
+    //! Number of cells diffused by the heat phase during the last Update()
+    int GetHeatCellCount() const { return heatCells; }
+
+    //! Phase timings of the most recent Update()
+    const TickTimings& GetLastTimings() const { return lastTimings; }
+
+    //! Work counters of the most recent Update()
+    const TickCounters& GetLastCounters() const { return lastCounters; }
+};
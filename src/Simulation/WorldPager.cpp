@@ -0,0 +1,373 @@
+#include "WorldPager.h"
+#include "ThermalKernel.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+//! Chunks per page edge and pending-rect ints per page
+static const int PAGE_CHUNKS = WorldPager::PAGE_SIZE / World::CHUNK_SIZE;
+static const int PAGE_CELLS = WorldPager::PAGE_SIZE * WorldPager::PAGE_SIZE;
+static_assert(WorldPager::PAGE_SIZE % World::CHUNK_SIZE == 0, "Pages hold whole chunks");
+
+static const CellTemp AMBIENT_CELL_TEMP = EncodeTemp(AMBIENT_TEMP);
+
+//! Rect of a chunk nothing is scheduled in (see Chunk)
+static const std::int32_t ASLEEP[4] = { INT_MAX, INT_MAX, INT_MIN, INT_MIN };
+
+static bool SeekTo(std::FILE* f, std::uint64_t offset) {
+#ifdef _MSC_VER
+    return _fseeki64(f, (long long)offset, SEEK_SET) == 0;
+#else
+    return fseeko(f, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+//! --- VARINTS (LEB128) ---
+static void PutVarint(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((std::uint8_t)v);
+}
+
+static bool GetVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) return false;
+        std::uint8_t b = *p++;
+        v |= (std::uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+//! Temperatures are compared and stored bit for bit: paging must not change the simulation
+static bool SameTemp(CellTemp a, CellTemp b) { return std::memcmp(&a, &b, sizeof(CellTemp)) == 0; }
+
+WorldPager::WorldPager(World& world, int pagesX, int pagesY, const std::string& storePath)
+    : world(world), storePath(storePath) {
+    //! A window of partial pages cannot be paged: it then stays the whole world (IsOpen() is false)
+    wholePages = world.GetWidth() % PAGE_SIZE == 0 && world.GetHeight() % PAGE_SIZE == 0;
+    windowPagesX = (world.GetWidth() + PAGE_SIZE - 1) >> PAGE_SHIFT;
+    windowPagesY = (world.GetHeight() + PAGE_SIZE - 1) >> PAGE_SHIFT;
+    this->pagesX = wholePages ? std::max(pagesX, windowPagesX) : windowPagesX;
+    this->pagesY = wholePages ? std::max(pagesY, windowPagesY) : windowPagesY;
+
+    slots.resize((std::size_t)this->pagesX * this->pagesY);
+    pageCells.resize(PAGE_CELLS);
+    pageTemps.resize(PAGE_CELLS);
+    if (wholePages) store = std::fopen(storePath.c_str(), "w+b");
+    world.SetOrigin(0, 0);
+    world.SetOpenEdges(GetOpenEdges());
+}
+
+WorldPager::~WorldPager() {
+    if (store) {
+        std::fclose(store);
+        std::remove(storePath.c_str());
+    }
+}
+
+bool WorldPager::Follow(int x, int y) {
+    int px = std::min(std::max(x, 0) >> PAGE_SHIFT, pagesX - 1);
+    int py = std::min(std::max(y, 0) >> PAGE_SHIFT, pagesY - 1);
+
+    //! Narrow windows move only once the point leaves them
+    int marginX = std::min(FOLLOW_MARGIN, (windowPagesX - 1) / 2);
+    int marginY = std::min(FOLLOW_MARGIN, (windowPagesY - 1) / 2);
+    bool nearEdge = px - windowX < marginX || windowX + windowPagesX - 1 - px < marginX ||
+                    py - windowY < marginY || windowY + windowPagesY - 1 - py < marginY;
+    if (!nearEdge) return false;
+
+    int oldX = windowX, oldY = windowY;
+    MoveWindow(px - windowPagesX / 2, py - windowPagesY / 2);
+    return windowX != oldX || windowY != oldY;
+}
+
+int WorldPager::GetOpenEdges() const {
+    int edges = 0;
+    if (windowX > 0) edges |= World::EDGE_LEFT;
+    if (windowY > 0) edges |= World::EDGE_TOP;
+    if (windowX + windowPagesX < pagesX) edges |= World::EDGE_RIGHT;
+    if (windowY + windowPagesY < pagesY) edges |= World::EDGE_BOTTOM;
+    return edges;
+}
+
+void WorldPager::MoveWindow(int pageX, int pageY) {
+    pageX = std::min(std::max(pageX, 0), pagesX - windowPagesX);
+    pageY = std::min(std::max(pageY, 0), pagesY - windowPagesY);
+    if (!store || (pageX == windowX && pageY == windowY)) return;
+
+    lastMoveMs = 0.0;
+    ScopedTimer timer(lastMoveMs);
+
+    int shiftX = pageX - windowX, shiftY = pageY - windowY;
+    world.GetPendingRects(pending);
+    nextPending.resize(pending.size());
+
+    //! 1. Pages the window leaves go to the swap file
+    for (int wy = 0; wy < windowPagesY; wy++) {
+        for (int wx = 0; wx < windowPagesX; wx++) {
+            int nx = wx - shiftX, ny = wy - shiftY;
+            if (nx >= 0 && ny >= 0 && nx < windowPagesX && ny < windowPagesY) continue;
+            PageOut(wx, wy, (windowY + wy) * pagesX + windowX + wx);
+        }
+    }
+
+    //! 2. Pages that stay move in place. Source = destination + a constant page offset, so walking
+    //!    toward the sources reads every page before it is overwritten.
+    int count = windowPagesX * windowPagesY;
+    std::vector<std::uint8_t> kept(count, 0);
+    bool ascending = shiftY * windowPagesX + shiftX > 0;
+    for (int k = 0; k < count; k++) {
+        int d = ascending ? k : count - 1 - k;
+        int dx = d % windowPagesX, dy = d / windowPagesX;
+        int sx = dx + shiftX, sy = dy + shiftY;
+        if (sx < 0 || sy < 0 || sx >= windowPagesX || sy >= windowPagesY) continue;
+        MovePage(sx, sy, dx, dy);
+        kept[d] = 1;
+    }
+
+    //! 3. The rest comes from the swap file
+    for (int d = 0; d < count; d++) {
+        if (kept[d]) continue;
+        int wx = d % windowPagesX, wy = d / windowPagesX;
+        PageIn((pageY + wy) * pagesX + pageX + wx, wx, wy);
+    }
+
+    windowX = pageX;
+    windowY = pageY;
+    WakeSeams(kept);
+
+    world.SetOrigin(windowX << PAGE_SHIFT, windowY << PAGE_SHIFT);
+    world.SetOpenEdges(GetOpenEdges());
+    world.Restore(world.GetSeed(), world.GetTick(), nextPending.data());
+}
+
+void WorldPager::Reset() {
+    world.Reset();
+    for (Slot& slot : slots) slot = Slot();
+    if (!wholePages) return;
+    if (store) std::fclose(store);
+    store = std::fopen(storePath.c_str(), "w+b");
+    storeEnd = 0;
+}
+
+WorldPager::Stats WorldPager::GetStats() const {
+    Stats s;
+    s.residentPages = windowPagesX * windowPagesY;
+    s.storedPages = (int)std::count_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.size > 0; });
+    s.storeBytes = storeEnd;
+    s.pagesIn = pagesIn;
+    s.pagesOut = pagesOut;
+    s.ioErrors = ioErrors;
+    s.lastMoveMs = lastMoveMs;
+    return s;
+}
+
+void WorldPager::PageOut(int wx, int wy, int page) {
+    const GridLayout& layout = world.GetLayout();
+    const int chunksX = world.GetChunksX();
+    const CellType* cells = world.GetGridData().data();
+    const CellTemp* temps = world.GetTempData().data();
+    int left = wx << PAGE_SHIFT, top = wy << PAGE_SHIFT;
+
+    //! Gather the page, noting whether anything in it differs from an empty page
+    bool empty = true;
+    for (int y = 0; y < PAGE_SIZE; y++) {
+        layout.ForEachRun(left, top + y, PAGE_SIZE, [&](int src, int offset, int length) {
+            std::memcpy(&pageCells[y * PAGE_SIZE + offset], cells + src, length * sizeof(CellType));
+            std::memcpy(&pageTemps[y * PAGE_SIZE + offset], temps + src, length * sizeof(CellTemp));
+        });
+    }
+    for (int i = 0; i < PAGE_CELLS && empty; i++) empty = pageCells[i] == EMPTY && SameTemp(pageTemps[i], AMBIENT_CELL_TEMP);
+
+    encoded.clear();
+
+    //! Element IDs: (id, length - 1) runs
+    for (int i = 0; i < PAGE_CELLS;) {
+        int run = 1;
+        while (i + run < PAGE_CELLS && pageCells[i + run] == pageCells[i]) run++;
+        encoded.push_back(pageCells[i]);
+        PutVarint(encoded, (std::uint32_t)(run - 1));
+        i += run;
+    }
+
+    //! Temperatures: (length - 1, raw bytes) runs
+    for (int i = 0; i < PAGE_CELLS;) {
+        int run = 1;
+        while (i + run < PAGE_CELLS && SameTemp(pageTemps[i + run], pageTemps[i])) run++;
+        PutVarint(encoded, (std::uint32_t)(run - 1));
+        const std::uint8_t* raw = reinterpret_cast<const std::uint8_t*>(&pageTemps[i]);
+        encoded.insert(encoded.end(), raw, raw + sizeof(CellTemp));
+        i += run;
+    }
+
+    //! Pending rects, page-relative
+    for (int cy = 0; cy < PAGE_CHUNKS; cy++) {
+        for (int cx = 0; cx < PAGE_CHUNKS; cx++) {
+            const std::int32_t* r = &pending[(((wy * PAGE_CHUNKS) + cy) * chunksX + wx * PAGE_CHUNKS + cx) * World::PENDING_INTS];
+            for (int k = 0; k < World::PENDING_INTS; k += 4) {
+                if (r[k] > r[k + 2]) {
+                    encoded.push_back(0);
+                    continue;
+                }
+                empty = false;
+                PutVarint(encoded, (std::uint32_t)(r[k] - left + 1));
+                PutVarint(encoded, (std::uint32_t)(r[k + 1] - top));
+                PutVarint(encoded, (std::uint32_t)(r[k + 2] - left));
+                PutVarint(encoded, (std::uint32_t)(r[k + 3] - top));
+            }
+        }
+    }
+
+    pagesOut++;
+    Slot& slot = slots[page];
+    slot.size = 0;
+    if (empty) return;
+
+    //! Rewrite in place when the page still fits its old space, append otherwise
+    std::uint32_t size = (std::uint32_t)encoded.size();
+    if (size > slot.capacity) {
+        slot.offset = storeEnd;
+        slot.capacity = size;
+        storeEnd += size;
+    }
+    if (!SeekTo(store, slot.offset) || std::fwrite(encoded.data(), 1, size, store) != size) {
+        ioErrors++;
+        return;
+    }
+    slot.size = size;
+}
+
+void WorldPager::PageIn(int page, int wx, int wy) {
+    const GridLayout& layout = world.GetLayout();
+    const int chunksX = world.GetChunksX();
+    int left = wx << PAGE_SHIFT, top = wy << PAGE_SHIFT;
+    const Slot& slot = slots[page];
+
+    bool loaded = false;
+    if (slot.size > 0) {
+        encoded.resize(slot.size);
+        loaded = SeekTo(store, slot.offset) && std::fread(encoded.data(), 1, slot.size, store) == slot.size;
+
+        const std::uint8_t* p = encoded.data();
+        const std::uint8_t* end = p + encoded.size();
+        std::uint32_t run = 0;
+
+        for (int i = 0; loaded && i < PAGE_CELLS;) {
+            loaded = p < end && IsSimElement(*p);
+            CellType id = loaded ? *p++ : (CellType)EMPTY;
+            loaded = loaded && GetVarint(p, end, run) && run < (std::uint32_t)(PAGE_CELLS - i);
+            if (loaded) std::fill(&pageCells[i], &pageCells[i] + run + 1, id);
+            i += run + 1;
+        }
+        for (int i = 0; loaded && i < PAGE_CELLS;) {
+            loaded = GetVarint(p, end, run) && run < (std::uint32_t)(PAGE_CELLS - i) && end - p >= (std::ptrdiff_t)sizeof(CellTemp);
+            if (!loaded) break;
+            CellTemp t;
+            std::memcpy(&t, p, sizeof(CellTemp));
+            p += sizeof(CellTemp);
+            std::fill(&pageTemps[i], &pageTemps[i] + run + 1, t);
+            i += run + 1;
+        }
+        for (int c = 0; loaded && c < PAGE_CHUNKS * PAGE_CHUNKS; c++) {
+            std::int32_t* r = &nextPending[((wy * PAGE_CHUNKS + c / PAGE_CHUNKS) * chunksX + wx * PAGE_CHUNKS + c % PAGE_CHUNKS) * World::PENDING_INTS];
+            for (int k = 0; loaded && k < World::PENDING_INTS; k += 4) {
+                std::uint32_t v[4] = {};
+                loaded = GetVarint(p, end, v[0]);
+                if (loaded && v[0] == 0) {
+                    std::copy(ASLEEP, ASLEEP + 4, r + k);
+                    continue;
+                }
+                loaded = loaded && GetVarint(p, end, v[1]) && GetVarint(p, end, v[2]) && GetVarint(p, end, v[3]);
+                if (!loaded) break;
+                r[k] = left + (std::int32_t)v[0] - 1; r[k + 1] = top + (std::int32_t)v[1];
+                r[k + 2] = left + (std::int32_t)v[2]; r[k + 3] = top + (std::int32_t)v[3];
+            }
+        }
+        loaded = loaded && p == end;
+        if (!loaded) ioErrors++;
+    }
+
+    //! Never stored (or unreadable): an empty page at ambient temperature with nothing to do
+    if (!loaded) {
+        std::fill(pageCells.begin(), pageCells.end(), (CellType)EMPTY);
+        std::fill(pageTemps.begin(), pageTemps.end(), AMBIENT_CELL_TEMP);
+        for (int c = 0; c < PAGE_CHUNKS * PAGE_CHUNKS; c++) {
+            std::int32_t* r = &nextPending[((wy * PAGE_CHUNKS + c / PAGE_CHUNKS) * chunksX + wx * PAGE_CHUNKS + c % PAGE_CHUNKS) * World::PENDING_INTS];
+            for (int k = 0; k < World::PENDING_INTS; k += 4) std::copy(ASLEEP, ASLEEP + 4, r + k);
+        }
+    }
+
+    CellType* cells = world.GetGridBuffer();
+    CellTemp* temps = world.GetTempBuffer();
+    for (int y = 0; y < PAGE_SIZE; y++) {
+        layout.ForEachRun(left, top + y, PAGE_SIZE, [&](int dst, int offset, int length) {
+            std::memcpy(cells + dst, &pageCells[y * PAGE_SIZE + offset], length * sizeof(CellType));
+            std::memcpy(temps + dst, &pageTemps[y * PAGE_SIZE + offset], length * sizeof(CellTemp));
+        });
+    }
+    pagesIn++;
+}
+
+void WorldPager::MovePage(int sx, int sy, int dx, int dy) {
+    const GridLayout& layout = world.GetLayout();
+    const int chunksX = world.GetChunksX();
+    CellType* cells = world.GetGridBuffer();
+    CellTemp* temps = world.GetTempBuffer();
+
+    int offsetX = (dx - sx) << PAGE_SHIFT, offsetY = (dy - sy) << PAGE_SHIFT;
+    //! Pages are whole tiles, so source and destination runs line up
+    for (int y = 0; y < PAGE_SIZE; y++) {
+        layout.ForEachRun(sx << PAGE_SHIFT, (sy << PAGE_SHIFT) + y, PAGE_SIZE, [&](int src, int offset, int length) {
+            int dst = layout.Index((dx << PAGE_SHIFT) + offset, (dy << PAGE_SHIFT) + y);
+            std::memcpy(cells + dst, cells + src, length * sizeof(CellType));
+            std::memcpy(temps + dst, temps + src, length * sizeof(CellTemp));
+        });
+    }
+
+    for (int cy = 0; cy < PAGE_CHUNKS; cy++) {
+        for (int cx = 0; cx < PAGE_CHUNKS; cx++) {
+            const std::int32_t* r = &pending[((sy * PAGE_CHUNKS + cy) * chunksX + sx * PAGE_CHUNKS + cx) * World::PENDING_INTS];
+            std::int32_t* n = &nextPending[((dy * PAGE_CHUNKS + cy) * chunksX + dx * PAGE_CHUNKS + cx) * World::PENDING_INTS];
+            for (int k = 0; k < World::PENDING_INTS; k += 4) {
+                if (r[k] > r[k + 2]) {
+                    std::copy(ASLEEP, ASLEEP + 4, n + k);
+                    continue;
+                }
+                n[k] = r[k] + offsetX; n[k + 1] = r[k + 1] + offsetY;
+                n[k + 2] = r[k + 2] + offsetX; n[k + 3] = r[k + 3] + offsetY;
+            }
+        }
+    }
+}
+
+void WorldPager::WakeSeams(const std::vector<std::uint8_t>& kept) {
+    const int chunksX = world.GetChunksX();
+    const int chunksY = world.GetChunksY();
+    auto pageOf = [&](int cx, int cy) { return (cy / PAGE_CHUNKS) * windowPagesX + cx / PAGE_CHUNKS; };
+
+    //! Sand resting on the old window edge may now fall into a paged-in page and vice versa.
+    //! Seams between two paged-in pages count too: they may have been window edges when the pages
+    //! were stored, with cells waiting on them.
+    for (int cy = 0; cy < chunksY; cy++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            int page = pageOf(cx, cy);
+            bool seam = false;
+            for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, chunksY - 1) && !seam; ny++) {
+                for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, chunksX - 1); nx++) {
+                    int other = pageOf(nx, ny);
+                    seam |= other != page && (!kept[page] || !kept[other]);
+                }
+            }
+            if (!seam) continue;
+
+            int left = cx * World::CHUNK_SIZE, top = cy * World::CHUNK_SIZE;
+            std::int32_t* r = &nextPending[(cy * chunksX + cx) * World::PENDING_INTS];
+            for (int k = 0; k < World::PENDING_INTS; k += 4) {
+                r[k] = left; r[k + 1] = top;
+                r[k + 2] = left + World::CHUNK_SIZE - 1; r[k + 3] = top + World::CHUNK_SIZE - 1;
+            }
+        }
+    }
+}
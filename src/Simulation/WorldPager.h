@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "World.h"
+
+//! Streams a world larger than memory through a resident World window.
+//!
+//! The streamed world is a grid of pages (PAGE_SIZE cells square). The World passed in holds
+//! the resident window of pages and is simulated as usual; physics and heat cross chunk and page
+//! borders inside it seamlessly. Pages outside the window are frozen: when the window moves
+//! (Follow, MoveWindow), the pages it leaves are compressed into a swap file together with their
+//! pending dirty rects, and the pages it reaches are read back (or start empty if they were never
+//! touched), so a paged-in region continues exactly where it stopped. Untouched and empty pages
+//! take no space at all.
+//!
+//! The window moves only when told to (Follow the viewport, MoveWindow), not when activity
+//! reaches its edge. Window edges facing frozen pages are open edges of the World: cells that
+//! reach one wait there (nothing is destroyed or changed, gas escapes only at the top of the
+//! whole world) and carry on across it once the window moves and wakes the seam.
+//!
+//! Page encoding (lossless): element IDs as (id, varint length - 1) runs, temperatures as
+//! (varint length - 1, raw value) runs, then the movement and heat rect of every chunk as
+//! varints relative to the page corner (0 = asleep, else minX + 1, minY, maxX, maxY).
+class WorldPager {
+public:
+    static const int PAGE_SHIFT = 8;
+    static const int PAGE_SIZE = 1 << PAGE_SHIFT;     //! Cells per page edge (8 chunks)
+
+    //! Pages kept between the followed point and the window edge before the window moves
+    static const int FOLLOW_MARGIN = 1;
+
+    struct Stats {
+        int residentPages;
+        int storedPages;            //! Non-empty pages in the swap file
+        std::uint64_t storeBytes;   //! Swap file size
+        int pagesIn, pagesOut;      //! Since construction
+        int ioErrors;               //! Pages lost to failed writes or unreadable slots (they come back empty)
+        double lastMoveMs;          //! Cost of the last window move
+    };
+
+    //! 'world' is the window (both dimensions multiples of PAGE_SIZE, or nothing is paged and
+    //! IsOpen() is false); the streamed world is pagesX x pagesY pages with the window at page
+    //! (0, 0). 'storePath' is the swap file, created (or truncated) here and removed by the
+    //! destructor.
+    WorldPager(World& world, int pagesX, int pagesY, const std::string& storePath);
+    ~WorldPager();
+
+    WorldPager(const WorldPager&) = delete;
+    WorldPager& operator=(const WorldPager&) = delete;
+
+    //! False if the window is not whole pages or the swap file could not be created (the window
+    //! then cannot move)
+    bool IsOpen() const { return store != nullptr; }
+
+    //! Streamed world size in cells
+    int GetWidth() const { return pagesX << PAGE_SHIFT; }
+    int GetHeight() const { return pagesY << PAGE_SHIFT; }
+
+    //! Centers the window on streamed cell (x, y) once it comes within FOLLOW_MARGIN pages of the
+    //! window edge (viewport center, region of interest). True if the window moved.
+    bool Follow(int x, int y);
+
+    //! Moves the window's top-left corner to page (pageX, pageY), clamped to the streamed world
+    void MoveWindow(int pageX, int pageY);
+
+    //! Clears the whole streamed world (resident window and swap file)
+    void Reset();
+
+    Stats GetStats() const;
+
+    //! World::EDGE_* bits of the window edges that face frozen pages
+    int GetOpenEdges() const;
+
+private:
+    //! Where a page lives in the swap file (size 0 = empty page; the space is reused by later writes)
+    struct Slot {
+        std::uint64_t offset = 0;
+        std::uint32_t size = 0;
+        std::uint32_t capacity = 0;
+    };
+
+    World& world;
+    int pagesX, pagesY;
+    int windowPagesX, windowPagesY;
+    int windowX = 0, windowY = 0;   //! Window position in pages
+    bool wholePages;                //! The window is whole pages (else it is never paged)
+
+    std::string storePath;
+    std::FILE* store = nullptr;
+    std::uint64_t storeEnd = 0;
+    std::vector<Slot> slots;        //! pagesX * pagesY
+
+    //! Scratch of one page move (reused)
+    std::vector<std::int32_t> pending, nextPending;
+    std::vector<CellType> pageCells;
+    std::vector<CellTemp> pageTemps;
+    std::vector<std::uint8_t> encoded;
+
+    int pagesIn = 0, pagesOut = 0, ioErrors = 0;
+    double lastMoveMs = 0.0;
+
+    //! Encodes the resident page at window page (wx, wy) into the slot of streamed page 'page'
+    void PageOut(int wx, int wy, int page);
+
+    //! Decodes streamed page 'page' into window page (wx, wy) (empty if never stored)
+    void PageIn(int page, int wx, int wy);
+
+    //! Copies window page (sx, sy) over window page (dx, dy), pending rects included
+    void MovePage(int sx, int sy, int dx, int dy);
+
+    //! Wakes whole chunks on both sides of every seam between pages with a paged-in page on
+    //! either side
+    void WakeSeams(const std::vector<std::uint8_t>& kept);
+};
@@ -2,117 +2,268 @@
 #include "Core/Constants.h"
 #include "Simulation/World.h"
 #include "Simulation/Elements.h"
+#include "Simulation/Random.h"
 #include "Graphics/Renderer.h"
 #include "Graphics/DebugOverlay.h"
+#include "Graphics/Viewport.h"
+#include "Simulation/Snapshot.h"
+#include "Simulation/SimulationRunner.h"
+#include "Simulation/WorldPager.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+int main(int argc, char** argv) {
+    //! World size: --width W --height H (defaults fill the window at Config::SCALE)
+    //! --load FILE resumes a snapshot (its size wins), --csv FILE streams the profiler every frame
+    //! --threaded runs the simulation on its own thread at --tick-rate HZ, --fps N caps drawing
+    //! --stream N pages an N x N page world through the grid, which becomes the window that follows the camera
+    //! --coarse-heat starts with the coarse heat mode on (H toggles it)
+    int simWidth = Config::SIM_WIDTH;
+    int simHeight = Config::SIM_HEIGHT;
+    const char* loadPath = nullptr;
+    const char* csvPath = nullptr;
+    bool threaded = false;
+    double tickRate = Config::TICK_RATE;
+    int targetFps = Config::TARGET_FPS;
+    int streamPages = 0;
+    bool coarseHeat = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threaded") == 0) threaded = true;
+        else if (std::strcmp(argv[i], "--coarse-heat") == 0) coarseHeat = true;
+        else if (std::strcmp(argv[i], "--width") == 0 && hasValue) simWidth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--height") == 0 && hasValue) simHeight = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--load") == 0 && hasValue) loadPath = argv[++i];
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) csvPath = argv[++i];
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && hasValue) tickRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--fps") == 0 && hasValue) targetFps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--stream") == 0 && hasValue) streamPages = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--width W] [--height H] [--load FILE] [--csv FILE] [--threaded] [--tick-rate HZ] [--fps N] [--stream N] [--coarse-heat]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (simWidth < 3) simWidth = Config::SIM_WIDTH;
+    if (simHeight < 3) simHeight = Config::SIM_HEIGHT;
+
+    Snapshot::Info snapshotInfo;
+    bool loadSized = loadPath && Snapshot::ReadInfo(loadPath, snapshotInfo);
+    if (loadSized) {
+        simWidth = snapshotInfo.width;
+        simHeight = snapshotInfo.height;
+    }
+
+    //! The streamed window holds whole pages, at least 3 x 3 so the camera can reach its margin.
+    //! A loaded snapshot sets the window size, so it must already be one.
+    if (streamPages > 0) {
+        const int minSize = 3 * WorldPager::PAGE_SIZE;
+        if (loadSized) {
+            if (simWidth % WorldPager::PAGE_SIZE != 0 || simHeight % WorldPager::PAGE_SIZE != 0 || simWidth < minSize || simHeight < minSize) {
+                std::fprintf(stderr, "Cannot stream from '%s': its %d x %d cells are not whole %d-cell pages, at least %d x %d\n",
+                    loadPath, simWidth, simHeight, WorldPager::PAGE_SIZE, minSize, minSize);
+                return 1;
+            }
+        }
+        else {
+            simWidth = std::max((simWidth + WorldPager::PAGE_SIZE - 1) & ~(WorldPager::PAGE_SIZE - 1), minSize);
+            simHeight = std::max((simHeight + WorldPager::PAGE_SIZE - 1) & ~(WorldPager::PAGE_SIZE - 1), minSize);
+        }
+    }
 
-int main() {
     InitWindow(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, "Dino");
-    SetTargetFPS(60);
+    SetTargetFPS(targetFps);
+    unsigned int seed = (unsigned int)time(nullptr);
+    Random::Seed(seed);
 
     //! Initialize Modules
-    World world(Config::SIM_WIDTH, Config::SIM_HEIGHT);
-    Renderer renderer(Config::SIM_WIDTH, Config::SIM_HEIGHT);
+    World world(simWidth, simHeight);
+    world.SetSeed(seed);
+    world.SetCoarseHeat(coarseHeat);
+    if (loadPath && !Snapshot::Load(loadPath, world)) std::fprintf(stderr, "Cannot load snapshot '%s'\n", loadPath);
+    Viewport view(simWidth, simHeight, Config::SCREEN_WIDTH, Config::SIM_HEIGHT_PIXELS);
+    Renderer renderer(view.GetMaxVisibleWidth(), view.GetMaxVisibleHeight());
     DebugOverlay debugger;
+    Profiler profiler;
+    if (csvPath && !profiler.OpenCsv(csvPath)) std::fprintf(stderr, "Cannot write '%s'\n", csvPath);
+
+    //! From here on the World is only touched through the runner (commands and frames)
+    std::unique_ptr<WorldPager> pager;
+    if (streamPages > 0) {
+        pager = std::make_unique<WorldPager>(world, streamPages, streamPages, Config::PAGE_FILE);
+        if (!pager->IsOpen()) std::fprintf(stderr, "Cannot write '%s', the world will not stream\n", Config::PAGE_FILE);
+    }
+    WorldPager* streamer = pager.get();
+
+    SimulationRunner runner(world);
+    if (threaded) runner.Start(tickRate);
 
     int currentTool = SAND;
     int brushSize = 3;
+    bool stroking = false;      //! Left button held: strokes continue from the last painted cell
+    int strokeX = 0, strokeY = 0;
+
+    //! Streamed position of the window cell (0, 0) as last drawn: the camera and the brush work
+    //! in window cells, commands in streamed cells (the window may move before they run)
+    int shownOriginX = 0, shownOriginY = 0;
+    int followX = -1, followY = -1;
 
     while (!WindowShouldClose()) {
         Vector2 m = GetMousePosition();
 
         //! --- INPUT HANDLING ---
         if (IsKeyPressed(KEY_D)) debugger.Toggle();
-        if (IsKeyPressed(KEY_R)) world.Reset();
+        if (IsKeyPressed(KEY_R)) runner.Submit([streamer](World& w) {
+            if (streamer) streamer->Reset();
+            else w.Reset();
+        });
         if (IsKeyPressed(KEY_T)) renderer.ToggleThermalMode();
+        if (IsKeyPressed(KEY_H)) {
+            coarseHeat = !coarseHeat;
+            runner.Submit([on = coarseHeat](World& w) { w.SetCoarseHeat(on); });
+        }
 
-        brushSize += (int)GetMouseWheelMove();
-        if (brushSize < 1) brushSize = 1;
+        //! Quick save / load (same world size only)
+        if (IsKeyPressed(KEY_F5)) runner.Submit([](World& w) {
+            if (!Snapshot::Save(w, Config::SNAPSHOT_FILE)) std::fprintf(stderr, "Cannot write '%s'\n", Config::SNAPSHOT_FILE);
+        });
+        if (IsKeyPressed(KEY_F9)) runner.Submit([](World& w) {
+            if (!Snapshot::Load(Config::SNAPSHOT_FILE, w)) std::fprintf(stderr, "Cannot load '%s'\n", Config::SNAPSHOT_FILE);
+        });
+
+        //! Camera: Ctrl + wheel zooms at the cursor, right-drag or arrow keys pan
+        float wheel = GetMouseWheelMove();
+        if (IsKeyDown(KEY_LEFT_CONTROL)) {
+            if (wheel != 0.0f && view.ContainsScreen(m.x, m.y)) view.ZoomAt(m.x, m.y, wheel > 0 ? Config::ZOOM_STEP : 1.0f / Config::ZOOM_STEP);
+        }
+        else {
+            brushSize += (int)wheel;
+            if (brushSize < 1) brushSize = 1;
+        }
+
+        if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+            Vector2 d = GetMouseDelta();
+            view.Pan(d.x, d.y);
+        }
+        float pan = Config::PAN_SPEED * GetFrameTime();
+        if (IsKeyDown(KEY_LEFT)) view.Pan(pan, 0);
+        if (IsKeyDown(KEY_RIGHT)) view.Pan(-pan, 0);
+        if (IsKeyDown(KEY_UP)) view.Pan(0, pan);
+        if (IsKeyDown(KEY_DOWN)) view.Pan(0, -pan);
+
+        //! Cell under the mouse (may lie outside the world)
+        int mx, my;
+        view.ScreenToCell(m.x, m.y, mx, my);
+        bool overWorld = view.ContainsScreen(m.x, m.y) && mx >= 0 && my >= 0 && mx < simWidth && my < simHeight;
 
         //! Drawing Input
-        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && m.y < Config::SIM_HEIGHT_PIXELS) {
-            int mx = (int)(m.x / Config::SCALE);
-            int my = (int)(m.y / Config::SCALE);
-
-            for (int y = -brushSize; y <= brushSize; y++) {
-                for (int x = -brushSize; x <= brushSize; x++) {
-                    int nx = mx + x;
-                    int ny = my + y;
-                    int index = ny * Config::SIM_WIDTH + nx;
-
-                    if (world.IsValid(index)) {
-                        int cellType = world.GetCell(index);
-                        const ElementDef& def = GetElementDef(cellType);
-                        float currentT = world.GetTemp(index);
-
-                        //! --- TOOL LOGIC ---
-                        if (currentTool == TOOL_HEAT || currentTool == TOOL_COOL) {
-
-                            //! 1. SOLID FILTER
-                            if (cellType == EMPTY) continue;
-
-                            //! 2. THERMAL RESISTANCE
-                            float thermalResistance = 1.0f;
-                            if (def.state == STATE_POWDER) thermalResistance = 5.0f;
-                            else if (def.state == STATE_LIQUID) thermalResistance = 5.0f;
-                            else if (def.state == STATE_STATIC) thermalResistance = 10.0f;
-
-                            float changeAmount = 100.0f / thermalResistance;
-
-                            if (currentTool == TOOL_HEAT) {
-                                float newTemp = currentT + changeAmount;
-                                if (newTemp > 9000.0f) newTemp = 9000.0f;
-                                world.SetTemp(index, newTemp);
-                            }
-                            else if (currentTool == TOOL_COOL) {
-                                float newTemp = currentT - changeAmount;
-                                if (newTemp < -273.0f) newTemp = -273.0f;
-                                world.SetTemp(index, newTemp);
-                            }
-                        }
-                        //! --- NORMAL DRAW ---
-                        else {
-                            if (currentTool != WALL && currentTool != EMPTY && cellType == WALL) continue;
-                            world.SetCell(index, currentTool);
-                        }
-                    }
-                }
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && view.ContainsScreen(m.x, m.y)) {
+            int tool = currentTool, brush = brushSize;
+            int cx = mx + shownOriginX, cy = my + shownOriginY;
+            int fromX = stroking ? strokeX : cx, fromY = stroking ? strokeY : cy;
+
+            if (tool == TOOL_HEAT || tool == TOOL_COOL) {
+                float delta = tool == TOOL_HEAT ? 100.0f : -100.0f;
+                runner.Submit([=](World& w) { w.ApplyHeatRegion(cx - w.GetOriginX(), cy - w.GetOriginY(), brush, delta); });
             }
+            else runner.Submit([=](World& w) {
+                int ox = w.GetOriginX(), oy = w.GetOriginY();
+                w.PaintStroke(fromX - ox, fromY - oy, cx - ox, cy - oy, brush, tool);
+            });
+
+            stroking = true;
+            strokeX = cx;
+            strokeY = cy;
         }
+        else stroking = false;
 
         //! --- UPDATE SIMULATION ---
-        world.Update();
+        //! Lockstep: one tick per frame. Threaded: the simulation thread ticks on its own clock
+        if (!runner.IsThreaded()) runner.Step();
+
+        const SimFrame& frame = runner.AcquireFrame();
+
+        //! Streaming: keep the camera on the same streamed cells when the window moves under it,
+        //! and page in around the view center whenever it enters a new page
+        if (frame.grid.originX != shownOriginX || frame.grid.originY != shownOriginY) {
+            float zoom = view.GetZoom();
+            view.Pan((frame.grid.originX - shownOriginX) * zoom, (frame.grid.originY - shownOriginY) * zoom);
+            shownOriginX = frame.grid.originX;
+            shownOriginY = frame.grid.originY;
+        }
+        if (streamer) {
+            int vx, vy;
+            view.ScreenToCell(view.GetScreenWidth() * 0.5f, view.GetScreenHeight() * 0.5f, vx, vy);
+            int px = (vx + shownOriginX) >> WorldPager::PAGE_SHIFT, py = (vy + shownOriginY) >> WorldPager::PAGE_SHIFT;
+            if (px != followX || py != followY) {
+                int lx = vx + shownOriginX, ly = vy + shownOriginY;
+                runner.Submit([streamer, lx, ly](World&) { streamer->Follow(lx, ly); });
+                followX = px;
+                followY = py;
+            }
+        }
+        {
+            const TickTimings& phase = frame.timings;
+            const TickCounters& work = frame.counters;
+            profiler.Record(PROF_UPDATE, frame.updateMs);
+            profiler.Record(PROF_THERMO, phase.thermo);
+            profiler.Record(PROF_SOLIDS, phase.solids);
+            profiler.Record(PROF_GASES, phase.gases);
+            profiler.Record(PROF_CELLS_MOVED, work.cellsMoved);
+            profiler.Record(PROF_REACTIONS, work.reactions);
+            profiler.Record(PROF_PHASE_CHANGES, work.phaseChanges);
+            profiler.Record(PROF_ACTIVE_CELLS, work.activeCells);
+            profiler.Record(PROF_HEAT_CELLS, work.heatCells);
+        }
 
         //! --- DRAW FRAME ---
         BeginDrawing();
         ClearBackground(Color{ 20, 20, 20, 255 });
 
-        renderer.DrawSimulation(world);
-        renderer.DrawUI(currentTool);
+        double renderMs = 0.0, uiMs = 0.0;
+        {
+            ScopedTimer timer(renderMs);
+            renderer.DrawSimulation(frame.grid, view);
+        }
+        {
+            ScopedTimer timer(uiMs);
+            renderer.DrawUI(currentTool);
+        }
+        profiler.Record(PROF_RENDER, renderMs);
+        profiler.Record(PROF_UI, uiMs);
 
         //! Cursor
-        if (m.y < Config::SIM_HEIGHT_PIXELS)
-            DrawRectangleLines((int)m.x - (brushSize * Config::SCALE), (int)m.y - (brushSize * Config::SCALE),
-                (brushSize * 2 + 1) * Config::SCALE, (brushSize * 2 + 1) * Config::SCALE, WHITE);
+        if (view.ContainsScreen(m.x, m.y)) {
+            float zoom = view.GetZoom();
+            DrawCircleLines((int)view.CellToScreenX(mx + 0.5f), (int)view.CellToScreenY(my + 0.5f), (brushSize + 0.5f) * zoom, WHITE);
+        }
 
         //! Debug & Info Overlay
-        int hoverX = (int)(m.x / Config::SCALE);
-        int hoverY = (int)(m.y / Config::SCALE);
-        int index = hoverY * Config::SIM_WIDTH + hoverX;
-        int cellType = world.GetCell(index);
-        float cellTemp = world.GetTemp(index);
+        int index = overWorld ? frame.grid.Index(mx, my) : -1;
+        int cellType = overWorld ? frame.grid.GetCell(index) : EMPTY;
+        float cellTemp = overWorld ? frame.grid.GetTemp(index) : 0.0f;
 
-        debugger.Draw(Config::SCREEN_WIDTH, Config::SIM_HEIGHT_PIXELS, Config::SCALE, (int)m.x, (int)m.y, index, cellType, cellTemp);
+        debugger.Draw(view, (int)m.x, (int)m.y, mx, my, index, cellType, cellTemp, renderer.GetUploadedBytes());
 
-        if (cellType != EMPTY && m.y < Config::SIM_HEIGHT_PIXELS) {
+        if (cellType != EMPTY && overWorld) {
             DrawText(TextFormat(GetElementName(cellType).c_str()), 10, 10, 20, RAYWHITE);
             DrawText(TextFormat("Temp: %.1f C", cellTemp), 10, 30, 20, RAYWHITE);
         }
 
         if (renderer.IsThermalMode()) DrawText("THERMAL MODE ON", 10, 30, 20, RED);
+        if (coarseHeat) DrawText("COARSE HEAT ON", 10, 50, 20, RED);
+
+        debugger.DrawProfiler(profiler, Config::SCREEN_WIDTH);
+        profiler.EndFrame(frame.grid.tick);
 
         EndDrawing();
     }
 
+    runner.Stop();
     CloseWindow();
     return 0;
 }
\ No newline at end of file